@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+/**
+ * @file apply_worker_pool.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "apply_worker_pool.h"
+
+ApplyWorkerPool::ApplyWorkerPool(int64_t worker_count)
+    : task_(nullptr), generation_(0), pending_(0), running_(true) {
+  for (int64_t w = 1; w < worker_count; w++) {
+    this->threads_.emplace_back(&ApplyWorkerPool::WorkerLoop, this, w);
+  }
+}
+
+ApplyWorkerPool::~ApplyWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->running_ = false;
+  }
+  this->task_cond_.notify_all();
+  for (auto& th : this->threads_) {
+    th.join();
+  }
+}
+
+void ApplyWorkerPool::Run(const std::function<void(int64_t)>& task) {
+  if (this->threads_.empty()) {
+    task(0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->task_ = &task;
+    this->pending_ = this->threads_.size();
+    this->generation_++;
+  }
+  this->task_cond_.notify_all();
+  task(0);
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  this->done_cond_.wait(lock, [this] { return this->pending_ == 0; });
+  this->task_ = nullptr;
+}
+
+int64_t ApplyWorkerPool::WorkerCount() {
+  return this->threads_.size() + 1;
+}
+
+void ApplyWorkerPool::WorkerLoop(int64_t worker) {
+  uint64_t seen = 0;
+  while (true) {
+    const std::function<void(int64_t)>* task = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex_);
+      this->task_cond_.wait(lock, [this, seen] {
+        return !this->running_ || this->generation_ != seen;
+      });
+      if (!this->running_) {
+        return;
+      }
+      seen = this->generation_;
+      task = this->task_;
+    }
+    (*task)(worker);
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->pending_--;
+    }
+    this->done_cond_.notify_one();
+  }
+}
@@ -0,0 +1,108 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+/**
+ * @file apply_worker_pool.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief a fixed set of threads running one task at a time on every worker,
+ * the caller thread works as worker 0 and Run returns when all of them are
+ * done, so a task may read and write the caller's state without locks
+ *
+ */
+class ApplyWorkerPool {
+
+ public:
+  /**
+   * @brief Construct a new Apply Worker Pool object
+   *
+   * @param worker_count workers including the caller, at least 1
+   */
+  explicit ApplyWorkerPool(int64_t worker_count);
+
+  /**
+   * @brief Destroy the Apply Worker Pool object, the threads are joined
+   *
+   */
+  ~ApplyWorkerPool();
+
+  /**
+   * @brief run task(w) for every worker w in [0, WorkerCount()) and wait
+   * for all of them, Run is called from one thread at a time
+   *
+   * @param task
+   */
+  void Run(const std::function<void(int64_t)>& task);
+
+  int64_t WorkerCount();
+
+ private:
+  void WorkerLoop(int64_t worker);
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+
+  /**
+   * @brief workers wait on it for a new task generation
+   *
+   */
+  std::condition_variable task_cond_;
+
+  /**
+   * @brief the caller waits on it for the workers to finish
+   *
+   */
+  std::condition_variable done_cond_;
+
+  const std::function<void(int64_t)>* task_;
+
+  /**
+   * @brief bumped for every Run, a worker runs each generation once
+   *
+   */
+  uint64_t generation_;
+
+  /**
+   * @brief threads still running the current generation
+   *
+   */
+  int64_t pending_;
+
+  bool running_;
+};
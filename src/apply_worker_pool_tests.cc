@@ -0,0 +1,80 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+/**
+ * @file apply_worker_pool_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "apply_worker_pool.h"
+
+TEST(ApplyWorkerPoolTest, RunOnEveryWorker) {
+  ApplyWorkerPool pool(4);
+  ASSERT_EQ(pool.WorkerCount(), 4);
+  std::vector<int64_t> hits(4, 0);
+  for (int64_t round = 1; round <= 1000; round++) {
+    pool.Run([&hits](int64_t w) { hits[w]++; });
+    for (int64_t w = 0; w < 4; w++) {
+      ASSERT_EQ(hits[w], round);
+    }
+  }
+}
+
+TEST(ApplyWorkerPoolTest, CallerRunsWorkerZero) {
+  ApplyWorkerPool pool(1);
+  ASSERT_EQ(pool.WorkerCount(), 1);
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id ran;
+  pool.Run([&ran](int64_t w) {
+    ASSERT_EQ(w, 0);
+    ran = std::this_thread::get_id();
+  });
+  ASSERT_EQ(ran, caller);
+}
+
+TEST(ApplyWorkerPoolTest, PartitionedSum) {
+  ApplyWorkerPool      pool(3);
+  std::vector<int64_t> vals(10000);
+  for (size_t i = 0; i < vals.size(); i++) {
+    vals[i] = i;
+  }
+  std::vector<int64_t> sums(pool.WorkerCount(), 0);
+  pool.Run([&vals, &sums, &pool](int64_t w) {
+    for (size_t i = w; i < vals.size(); i += pool.WorkerCount()) {
+      sums[w] += vals[i];
+    }
+  });
+  int64_t total = 0;
+  for (auto s : sums) {
+    total += s;
+  }
+  ASSERT_EQ(total, 9999 * 10000 / 2);
+}
@@ -43,6 +43,7 @@ Client::Client() {
     std::unique_ptr<ERaftKv::Stub> stub_(ERaftKv::NewStub(chan_));
     this->meta_svr_stubs_[metaserver_addr] = std::move(stub_);
   }
+  this->kv_leader_stub_ = nullptr;
   this->UpdateMetaServerLeaderStub();
   this->client_id_ = StringUtil::RandStr(16);
   this->command_id_ = 0;
@@ -57,6 +58,7 @@ Client::Client(std::string& metaserver_addrs) {
     std::unique_ptr<ERaftKv::Stub> stub_(ERaftKv::NewStub(chan_));
     this->meta_svr_stubs_[metaserver_addr] = std::move(stub_);
   }
+  this->kv_leader_stub_ = nullptr;
   this->UpdateMetaServerLeaderStub();
   this->client_id_ = StringUtil::RandStr(16);
   this->command_id_ = 0;
@@ -184,26 +186,22 @@ void Client::UpdateKvServerLeaderStubByPartitionKey(std::string partition_key) {
   }
   // cal key slot
   auto key_slot =
-      HashUtil::CRC64(0, partition_key.c_str(), partition_key.size()) % 10;
-  std::map<std::string, std::unique_ptr<ERaftKv::Stub> > kv_svr_stubs_;
-
+      HashUtil::CRC64(0, partition_key.c_str(), partition_key.size()) %
+      KEY_SLOT_COUNT;
   std::string kv_leader_address;
+  this->kv_replica_addrs_.clear();
   for (auto sg : cluster_config_resp.shard_group()) {
     for (auto sl : sg.slots()) {
       if (key_slot == sl.id()) {
         // find sg leader addr
         for (auto server : sg.servers()) {
-          auto new_chan_ = grpc::CreateChannel(
-              server.address(), grpc::InsecureChannelCredentials());
-          std::unique_ptr<ERaftKv::Stub> kv_stub(ERaftKv::NewStub(new_chan_));
-          kv_svr_stubs_[server.address()] = std::move(kv_stub);
-          SPDLOG_INFO("init rpc link to {} ", server.address());
+          this->kv_replica_addrs_.push_back(server.address());
           ClientContext                   query_kv_members_context;
           eraftkv::ClusterConfigChangeReq query_kv_members_req;
           query_kv_members_req.set_change_type(
               eraftkv::ChangeType::MembersQuery);
           eraftkv::ClusterConfigChangeResp query_kv_members_resp;
-          auto status = kv_svr_stubs_[server.address()]->ClusterConfigChange(
+          auto status = this->KvStub(server.address())->ClusterConfigChange(
               &query_kv_members_context,
               query_kv_members_req,
               &query_kv_members_resp);
@@ -224,9 +222,27 @@ void Client::UpdateKvServerLeaderStubByPartitionKey(std::string partition_key) {
     }
   }
   SPDLOG_INFO("kv server leader {}", kv_leader_address);
-  auto kv_leader_chan = grpc::CreateChannel(kv_leader_address,
-                                            grpc::InsecureChannelCredentials());
-  this->kv_leader_stub_ = std::move(ERaftKv::NewStub(kv_leader_chan));
+  this->kv_leader_stub_ = this->KvStub(kv_leader_address);
+}
+
+/**
+ * @brief the cached stub of a kv server, its channel is created on first
+ * use and reused by the later requests
+ *
+ * @param addr
+ * @return ERaftKv::Stub*
+ */
+ERaftKv::Stub* Client::KvStub(const std::string& addr) {
+  auto it = this->kv_svr_stubs_.find(addr);
+  if (it != this->kv_svr_stubs_.end()) {
+    return it->second.get();
+  }
+  SPDLOG_INFO("init rpc link to {} ", addr);
+  auto chan = grpc::CreateChannel(addr, grpc::InsecureChannelCredentials());
+  auto stub = ERaftKv::NewStub(chan);
+  auto stub_ptr = stub.get();
+  this->kv_svr_stubs_[addr] = std::move(stub);
+  return stub_ptr;
 }
 
 bool Client::PutKV(std::string k, std::string v) {
@@ -262,8 +278,21 @@ std::pair<std::string, std::string> Client::GetKV(std::string k) {
   kv_pair_->set_key(k);
   kv_pair_->set_op_type(eraftkv::ClientOpType::Get);
   kv_pair_->set_op_sign(RandomNumber::Between(1, 10000));
-  auto st =
-      this->kv_leader_stub_->ProcessRWOperation(&op_context, op_req, &op_resp);
+  // any replica of the shard group can serve a linearizable get, spread the
+  // reads and fall back to the leader if the replica can't serve it
+  grpc::Status st;
+  if (!this->kv_replica_addrs_.empty()) {
+    auto replica_addr = this->kv_replica_addrs_[RandomNumber::Between(
+        0, this->kv_replica_addrs_.size() - 1)];
+    st = this->KvStub(replica_addr)
+             ->ProcessRWOperation(&op_context, op_req, &op_resp);
+  }
+  if (!st.ok() || op_resp.ops_size() == 0) {
+    ClientContext leader_op_context;
+    op_resp.Clear();
+    st = this->kv_leader_stub_->ProcessRWOperation(
+        &leader_op_context, op_req, &op_resp);
+  }
   assert(st.ok());
   this->command_id_++;
   auto key = op_resp.ops(0).key();
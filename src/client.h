@@ -83,7 +83,15 @@ private:
 
     std::unique_ptr<ERaftKv::Stub> meta_leader_stub_;
 
-    std::unique_ptr<ERaftKv::Stub> kv_leader_stub_;
+    ERaftKv::Stub* KvStub(const std::string& addr);
+
+    // kv server stubs by address, a channel is kept open for every replica
+    // the client talked to
+    std::map<std::string, std::unique_ptr<ERaftKv::Stub> > kv_svr_stubs_;
+
+    ERaftKv::Stub* kv_leader_stub_;
+
+    std::vector<std::string> kv_replica_addrs_;
 
     std::string client_id_;
 
@@ -0,0 +1,81 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file committed_entry_queue.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "committed_entry_queue.h"
+
+CommittedEntryQueue::CommittedEntryQueue(uint64_t capacity)
+    : head_(0), tail_(0) {
+  uint64_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  this->slots_.resize(size);
+  this->mask_ = size - 1;
+}
+
+CommittedEntryQueue::~CommittedEntryQueue() {}
+
+bool CommittedEntryQueue::Push(eraftkv::Entry* ety) {
+  uint64_t tail = this->tail_.load(std::memory_order_relaxed);
+  // the acquire pairs with the release in Pop, the consumer is done with
+  // the slot before it is reused
+  if (tail - this->head_.load(std::memory_order_acquire) ==
+      this->slots_.size()) {
+    return false;
+  }
+  this->slots_[tail & this->mask_].Swap(ety);
+  this->tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+eraftkv::Entry* CommittedEntryQueue::Front() {
+  uint64_t head = this->head_.load(std::memory_order_relaxed);
+  if (head == this->tail_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &this->slots_[head & this->mask_];
+}
+
+void CommittedEntryQueue::Pop() {
+  uint64_t head = this->head_.load(std::memory_order_relaxed);
+  this->head_.store(head + 1, std::memory_order_release);
+}
+
+uint64_t CommittedEntryQueue::Size() {
+  return this->tail_.load(std::memory_order_acquire) -
+         this->head_.load(std::memory_order_acquire);
+}
+
+uint64_t CommittedEntryQueue::Capacity() {
+  return this->slots_.size();
+}
@@ -0,0 +1,111 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file committed_entry_queue.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "eraftkv.pb.h"
+
+/**
+ * @brief bounded lock free ring of parsed log entries between one producer
+ * and one consumer. entries are swapped in and out of the slots, so the
+ * slot buffers are reused and a payload is never copied
+ *
+ */
+class CommittedEntryQueue {
+
+ public:
+  /**
+   * @brief Construct a new Committed Entry Queue object
+   *
+   * @param capacity rounded up to a power of two
+   */
+  explicit CommittedEntryQueue(uint64_t capacity);
+
+  /**
+   * @brief Destroy the Committed Entry Queue object
+   *
+   */
+  ~CommittedEntryQueue();
+
+  /**
+   * @brief producer side, swap ety into the tail slot, ety is left with
+   * the stale content of the slot
+   *
+   * @param ety
+   * @return bool false if the queue is full, ety is untouched then
+   */
+  bool Push(eraftkv::Entry* ety);
+
+  /**
+   * @brief consumer side, the entry at the head, it stays valid until Pop
+   *
+   * @return eraftkv::Entry* nullptr if the queue is empty
+   */
+  eraftkv::Entry* Front();
+
+  /**
+   * @brief consumer side, release the head slot to the producer
+   *
+   */
+  void Pop();
+
+  /**
+   * @brief number of queued entries, exact only on the consumer side
+   *
+   * @return uint64_t
+   */
+  uint64_t Size();
+
+  uint64_t Capacity();
+
+ private:
+  std::vector<eraftkv::Entry> slots_;
+
+  uint64_t mask_;
+
+  /**
+   * @brief count of popped entries, written by the consumer only
+   *
+   */
+  alignas(64) std::atomic<uint64_t> head_;
+
+  /**
+   * @brief count of pushed entries, written by the producer only
+   *
+   */
+  alignas(64) std::atomic<uint64_t> tail_;
+};
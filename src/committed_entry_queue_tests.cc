@@ -0,0 +1,92 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file committed_entry_queue_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "committed_entry_queue.h"
+#include "eraftkv.pb.h"
+
+TEST(CommittedEntryQueueTest, PushPop) {
+  CommittedEntryQueue queue(3);
+  ASSERT_EQ(queue.Capacity(), 4);
+  ASSERT_EQ(queue.Front(), nullptr);
+  for (int64_t i = 1; i <= 4; i++) {
+    eraftkv::Entry ety;
+    ety.set_id(i);
+    ety.set_data("val" + std::to_string(i));
+    ASSERT_TRUE(queue.Push(&ety));
+  }
+  // a full queue leaves the entry with the producer
+  eraftkv::Entry ety;
+  ety.set_id(5);
+  ASSERT_FALSE(queue.Push(&ety));
+  ASSERT_EQ(ety.id(), 5);
+  ASSERT_EQ(queue.Size(), 4);
+  for (int64_t i = 1; i <= 4; i++) {
+    ASSERT_NE(queue.Front(), nullptr);
+    ASSERT_EQ(queue.Front()->id(), i);
+    ASSERT_EQ(queue.Front()->data(), "val" + std::to_string(i));
+    queue.Pop();
+  }
+  ASSERT_EQ(queue.Front(), nullptr);
+  ASSERT_TRUE(queue.Push(&ety));
+  ASSERT_EQ(queue.Front()->id(), 5);
+}
+
+TEST(CommittedEntryQueueTest, ProducerConsumer) {
+  CommittedEntryQueue queue(64);
+  const int64_t       count = 100000;
+  std::thread         producer([&queue, count] {
+    eraftkv::Entry ety;
+    for (int64_t i = 1; i <= count; i++) {
+      ety.set_id(i);
+      ety.set_data(std::to_string(i));
+      while (!queue.Push(&ety)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  eraftkv::Entry ety;
+  for (int64_t i = 1; i <= count; i++) {
+    while (queue.Front() == nullptr) {
+      std::this_thread::yield();
+    }
+    queue.Front()->Swap(&ety);
+    queue.Pop();
+    ASSERT_EQ(ety.id(), i);
+    ASSERT_EQ(ety.data(), std::to_string(i));
+  }
+  producer.join();
+  ASSERT_EQ(queue.Size(), 0);
+}
@@ -0,0 +1,134 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file compress_util.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "compress_util.h"
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include "consts.h"
+
+eraftkv::CompressType CompressUtil::ParseType(const std::string& name) {
+  if (name == "lz4") {
+    return eraftkv::LZ4Compress;
+  }
+  if (name == "zstd") {
+    return eraftkv::ZstdCompress;
+  }
+  return eraftkv::NoCompress;
+}
+
+bool CompressUtil::Compress(eraftkv::CompressType type,
+                            const char*           data,
+                            size_t                size,
+                            std::string*          out) {
+  switch (type) {
+    case eraftkv::LZ4Compress: {
+      if (size > LZ4_MAX_INPUT_SIZE) {
+        return false;
+      }
+      out->resize(LZ4_compressBound(size));
+      int n = LZ4_compress_default(data, &(*out)[0], size, out->size());
+      if (n <= 0) {
+        return false;
+      }
+      out->resize(n);
+      return true;
+    }
+    case eraftkv::ZstdCompress: {
+      out->resize(ZSTD_compressBound(size));
+      size_t n = ZSTD_compress(
+          &(*out)[0], out->size(), data, size, LOG_COMPRESS_ZSTD_LEVEL);
+      if (ZSTD_isError(n)) {
+        return false;
+      }
+      out->resize(n);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool CompressUtil::Decompress(eraftkv::CompressType type,
+                              const char*           data,
+                              size_t                size,
+                              size_t                raw_size,
+                              std::string*          out) {
+  out->resize(raw_size);
+  switch (type) {
+    case eraftkv::LZ4Compress: {
+      if (raw_size > LZ4_MAX_INPUT_SIZE) {
+        return false;
+      }
+      int n = LZ4_decompress_safe(data, &(*out)[0], size, raw_size);
+      return n >= 0 && static_cast<size_t>(n) == raw_size;
+    }
+    case eraftkv::ZstdCompress: {
+      size_t n = ZSTD_decompress(&(*out)[0], raw_size, data, size);
+      return !ZSTD_isError(n) && n == raw_size;
+    }
+    default:
+      return false;
+  }
+}
+
+bool CompressUtil::CompressPayload(eraftkv::CompressType type,
+                                   std::string*          payload) {
+  if (type == eraftkv::NoCompress ||
+      payload->size() < LOG_COMPRESS_MIN_BYTES) {
+    return false;
+  }
+  std::string out;
+  if (!Compress(type, payload->data(), payload->size(), &out) ||
+      out.size() >= payload->size()) {
+    return false;
+  }
+  payload->swap(out);
+  return true;
+}
+
+const std::string* CompressUtil::EntryData(const eraftkv::Entry& ety,
+                                           std::string*          buf) {
+  if (ety.compress_type() == eraftkv::NoCompress) {
+    return &ety.data();
+  }
+  if (ety.data_size() < 0 || !Decompress(ety.compress_type(),
+                                         ety.data().data(),
+                                         ety.data().size(),
+                                         ety.data_size(),
+                                         buf)) {
+    return nullptr;
+  }
+  return buf;
+}
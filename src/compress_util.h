@@ -0,0 +1,107 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file compress_util.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+
+#include "eraftkv.pb.h"
+
+/**
+ * @brief lz4 / zstd codecs of the raft log entry payloads
+ *
+ */
+class CompressUtil {
+
+ public:
+  /**
+   * @brief parse a compress type name, "none", "lz4" or "zstd"
+   *
+   * @param name
+   * @return eraftkv::CompressType, NoCompress for unknown names
+   */
+  static eraftkv::CompressType ParseType(const std::string& name);
+
+  /**
+   * @brief compress [data, data + size) into out
+   *
+   * @param type
+   * @param data
+   * @param size
+   * @param out
+   * @return true if out holds the compressed data
+   */
+  static bool Compress(eraftkv::CompressType type,
+                       const char*           data,
+                       size_t                size,
+                       std::string*          out);
+
+  /**
+   * @brief decompress [data, data + size) into out, raw_size is the size of
+   * the uncompressed data
+   *
+   * @param type
+   * @param data
+   * @param size
+   * @param raw_size
+   * @param out
+   * @return true if out holds raw_size bytes of uncompressed data
+   */
+  static bool Decompress(eraftkv::CompressType type,
+                         const char*           data,
+                         size_t                size,
+                         size_t                raw_size,
+                         std::string*          out);
+
+  /**
+   * @brief compress payload in place if it is big enough and shrinks
+   *
+   * @param type
+   * @param payload
+   * @return true if payload is compressed
+   */
+  static bool CompressPayload(eraftkv::CompressType type,
+                              std::string*          payload);
+
+  /**
+   * @brief the uncompressed payload of ety, buf holds the data of a
+   * compressed entry
+   *
+   * @param ety
+   * @param buf
+   * @return const std::string*, nullptr if the payload is corrupted
+   */
+  static const std::string* EntryData(const eraftkv::Entry& ety,
+                                      std::string*          buf);
+};
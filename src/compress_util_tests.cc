@@ -0,0 +1,110 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file compress_util_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "compress_util.h"
+#include "consts.h"
+
+static std::string JsonValue(int64_t n) {
+  std::string val;
+  for (int64_t i = 0; i < n; i++) {
+    val += "{\"user\":\"u" + std::to_string(i) + "\",\"status\":\"active\"},";
+  }
+  return val;
+}
+
+TEST(CompressUtilTest, ParseType) {
+  ASSERT_EQ(eraftkv::LZ4Compress, CompressUtil::ParseType("lz4"));
+  ASSERT_EQ(eraftkv::ZstdCompress, CompressUtil::ParseType("zstd"));
+  ASSERT_EQ(eraftkv::NoCompress, CompressUtil::ParseType("none"));
+  ASSERT_EQ(eraftkv::NoCompress, CompressUtil::ParseType("snappy"));
+}
+
+TEST(CompressUtilTest, RoundTrip) {
+  std::string raw = JsonValue(64);
+  for (auto type : {eraftkv::LZ4Compress, eraftkv::ZstdCompress}) {
+    std::string compressed;
+    ASSERT_TRUE(
+        CompressUtil::Compress(type, raw.data(), raw.size(), &compressed));
+    ASSERT_LT(compressed.size(), raw.size());
+    std::string out;
+    ASSERT_TRUE(CompressUtil::Decompress(
+        type, compressed.data(), compressed.size(), raw.size(), &out));
+    ASSERT_EQ(raw, out);
+    // a wrong raw size is refused
+    ASSERT_FALSE(CompressUtil::Decompress(
+        type, compressed.data(), compressed.size(), raw.size() + 1, &out));
+  }
+}
+
+TEST(CompressUtilTest, CompressPayload) {
+  std::string small = JsonValue(1).substr(0, LOG_COMPRESS_MIN_BYTES - 1);
+  ASSERT_FALSE(CompressUtil::CompressPayload(eraftkv::LZ4Compress, &small));
+  std::string raw = JsonValue(64);
+  std::string payload = raw;
+  ASSERT_FALSE(CompressUtil::CompressPayload(eraftkv::NoCompress, &payload));
+  ASSERT_EQ(raw, payload);
+  ASSERT_TRUE(CompressUtil::CompressPayload(eraftkv::ZstdCompress, &payload));
+  ASSERT_LT(payload.size(), raw.size());
+  // random bytes do not shrink and are kept as they are
+  std::mt19937 rng(42);
+  std::string  noise;
+  for (int64_t i = 0; i < 1024; i++) {
+    noise.push_back(static_cast<char>(rng()));
+  }
+  std::string noise_payload = noise;
+  ASSERT_FALSE(
+      CompressUtil::CompressPayload(eraftkv::LZ4Compress, &noise_payload));
+  ASSERT_EQ(noise, noise_payload);
+}
+
+TEST(CompressUtilTest, EntryData) {
+  std::string    raw = JsonValue(64);
+  eraftkv::Entry ety;
+  std::string    buf;
+  ety.set_data(raw);
+  ASSERT_EQ(&ety.data(), CompressUtil::EntryData(ety, &buf));
+  ASSERT_TRUE(CompressUtil::CompressPayload(eraftkv::LZ4Compress,
+                                            ety.mutable_data()));
+  ety.set_compress_type(eraftkv::LZ4Compress);
+  ety.set_data_size(raw.size());
+  // the codec and raw size survive the log and wire encoding
+  eraftkv::Entry parsed;
+  ASSERT_TRUE(parsed.ParseFromString(ety.SerializeAsString()));
+  ASSERT_EQ(eraftkv::LZ4Compress, parsed.compress_type());
+  ASSERT_EQ(raw, *CompressUtil::EntryData(parsed, &buf));
+  parsed.mutable_data()->resize(parsed.data().size() / 2);
+  ASSERT_EQ(nullptr, CompressUtil::EntryData(parsed, &buf));
+}
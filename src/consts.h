@@ -37,4 +37,84 @@
 
 #define SNAPSHOTING_KEY_SCAN_PRE_COOUNT 500
 
+#define SNAPSHOT_SEND_DIR "/eraft/data/sst_send/"
+
+#define SNAPSHOT_RECV_DIR "/eraft/data/sst_recv/"
+
+#define APPEND_ENTRIES_RPC_TIMEOUT_MS 1000
+
+#define REQUEST_VOTE_RPC_TIMEOUT_MS 500
+
+#define MAX_INFLIGHT_APPEND_REQS_PER_NODE 4
+
+#define MAX_ENTRIES_PER_APPEND_REQ 100
+
+#define MAX_BYTES_PER_APPEND_REQ (1 << 20)
+
+#define PROPOSE_BATCH_WINDOW_US 200
+
+#define PROPOSE_BATCH_MAX_BYTES (1 << 20)
+
+#define READ_INDEX_TIMEOUT_MS 1000
+
+#define HEARTBEAT_SEND_TIMES_KEEP 64
+
+#define TIMER_WHEEL_TICK_MS 10
+
+#define TIMER_WHEEL_SLOTS 512
+
+#define APPLY_WAIT_TIMEOUT_MS 100
+
+#define DEFAULT_RAFT_GROUP_ID 0
+
+#define RAFT_GROUP_ID_METADATA_KEY "eraft-group-id"
+
+#define RAFT_GROUP_APPLY_THREADS 4
+
+#define KEY_SLOT_COUNT 10
+
+#define LOG_GC_DELETION_WINDOW 1024
+
+#define LOG_GC_DELETION_TRIGGER 512
+
+#define LOG_ENTRY_CACHE_INIT_SIZE (64 << 10)
+
+#define LOG_ENTRY_CACHE_INIT_ENTRIES 64
+
+#define LOG_ENTRY_CACHE_MAX_MEM (64 << 20)
+
+#define SEGMENT_LOG_FILE_SIZE (64 << 20)
+
+#define SEGMENT_LOG_INDEX_INTERVAL 64
+
+#define SEGMENT_LOG_READ_AHEAD (256 << 10)
+
+#define SEGMENT_LOG_ENTRY_RECORD 1
+
+#define SEGMENT_LOG_META_RECORD 2
+
+#define LOG_COMPRESS_MIN_BYTES 128
+
+#define LOG_COMPRESS_ZSTD_LEVEL 1
+
+#define LOG_ENTRY_CF_NAME "log_entries"
+
+#define LOG_META_CF_NAME "log_meta"
+
+#define LOG_ENTRY_CF_WRITE_BUFFER_SIZE (64 << 20)
+
+#define LOG_ENTRY_CF_MAX_WRITE_BUFFERS 4
+
+#define LOG_META_CF_WRITE_BUFFER_SIZE (1 << 20)
+
+#define LOG_DB_MIGRATE_BATCH 1024
+
+#define LOG_KEY_FORMAT_VERSION 2
+
+#define LOG_ENTRY_READAHEAD_SIZE (2 << 20)
+
+#define COMMITTED_ENTRY_QUEUE_SIZE 4096
+
+#define APPLY_PARALLEL_MIN_ENTRIES 64
+
 #define DEFAULT_METASERVER_ADDRS "172.18.0.2:8088,172.18.0.3:8089,172.18.0.4:8090"
\ No newline at end of file
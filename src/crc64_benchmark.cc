@@ -0,0 +1,128 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file crc64_benchmark.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2023-05-21
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "util.h"
+
+/**
+ * @brief count random keys of key_size bytes
+ *
+ * @param count
+ * @param key_size
+ * @return std::vector<std::string>
+ */
+static std::vector<std::string> RandomKeys(int64_t count, int64_t key_size) {
+  std::mt19937             random_engine(42);
+  std::vector<std::string> keys;
+  for (int64_t i = 0; i < count; i++) {
+    std::string key(key_size, '\0');
+    for (auto& c : key) {
+      c = static_cast<char>(random_engine());
+    }
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+/**
+ * @brief hash one key of range(0) bytes with the byte at a time kernel
+ *
+ * @param state
+ */
+static void BM_CRC64Bytewise(benchmark::State& state) {
+  std::string key = RandomKeys(1, state.range(0))[0];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        HashUtil::CRC64Bytewise(0, key.data(), key.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CRC64Bytewise)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief hash one key of range(0) bytes with the dispatched kernel
+ *
+ * @param state
+ */
+static void BM_CRC64(benchmark::State& state) {
+  std::string key = RandomKeys(1, state.range(0))[0];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HashUtil::CRC64(0, key.data(), key.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CRC64)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief hash 64 keys of range(0) bytes one by one with the byte at a time
+ * kernel, the baseline of the batch
+ *
+ * @param state
+ */
+static void BM_CRC64BytewiseKeys(benchmark::State& state) {
+  std::vector<std::string> keys = RandomKeys(64, state.range(0));
+  std::vector<uint64_t>    crcs(keys.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      crcs[i] = HashUtil::CRC64Bytewise(0, keys[i].data(), keys[i].size());
+    }
+    benchmark::DoNotOptimize(crcs.data());
+  }
+  state.SetBytesProcessed(state.iterations() * keys.size() * state.range(0));
+}
+
+BENCHMARK(BM_CRC64BytewiseKeys)->Arg(16)->Arg(256);
+
+/**
+ * @brief hash 64 keys of range(0) bytes in one batch
+ *
+ * @param state
+ */
+static void BM_CRC64Batch(benchmark::State& state) {
+  std::vector<std::string> keys = RandomKeys(64, state.range(0));
+  std::vector<uint64_t>    crcs;
+  for (auto _ : state) {
+    HashUtil::CRC64Batch(keys, &crcs);
+    benchmark::DoNotOptimize(crcs.data());
+  }
+  state.SetBytesProcessed(state.iterations() * keys.size() * state.range(0));
+}
+
+BENCHMARK(BM_CRC64Batch)->Arg(16)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file crc64_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "util.h"
+
+static std::string RandomBytes(std::mt19937* random_engine, size_t size) {
+  std::string buf(size, '\0');
+  for (auto& c : buf) {
+    c = static_cast<char>((*random_engine)());
+  }
+  return buf;
+}
+
+TEST(CRC64Test, CheckValue) {
+  // the crc-64-jones check value redis uses
+  uint64_t want = UINT64_C(0xe9c6d914c4b8d9ca);
+  ASSERT_EQ(HashUtil::CRC64Bytewise(0, "123456789", 9), want);
+  ASSERT_EQ(HashUtil::CRC64Slice8(0, "123456789", 9), want);
+  ASSERT_EQ(HashUtil::CRC64(0, "123456789", 9), want);
+  ASSERT_EQ(HashUtil::CRC64(0, "", 0), 0);
+}
+
+TEST(CRC64Test, SplitBuffer) {
+  std::mt19937 random_engine(42);
+  std::string  buf = RandomBytes(&random_engine, 64);
+  for (uint64_t l = 0; l <= buf.size(); l++) {
+    uint64_t want = HashUtil::CRC64Bytewise(0, buf.data(), l);
+    for (uint64_t split = 0; split <= l; split++) {
+      uint64_t crc = HashUtil::CRC64Slice8(0, buf.data(), split);
+      crc = HashUtil::CRC64Slice8(crc, buf.data() + split, l - split);
+      ASSERT_EQ(crc, want) << "len " << l << " split " << split;
+      crc = HashUtil::CRC64(0, buf.data(), split);
+      crc = HashUtil::CRC64(crc, buf.data() + split, l - split);
+      ASSERT_EQ(crc, want) << "len " << l << " split " << split;
+    }
+  }
+}
+
+TEST(CRC64Test, Batch) {
+  std::mt19937             random_engine(42);
+  std::vector<std::string> keys;
+  // mixed lengths within a group of four and a tail shorter than four
+  for (size_t i = 0; i < 67; i++) {
+    keys.push_back(RandomBytes(&random_engine, (i * 7) % 41));
+  }
+  std::vector<uint64_t> crcs;
+  HashUtil::CRC64Batch(keys, &crcs);
+  ASSERT_EQ(crcs.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(crcs[i],
+              HashUtil::CRC64Bytewise(0, keys[i].data(), keys[i].size()))
+        << "key " << i;
+  }
+  HashUtil::CRC64Batch({}, &crcs);
+  ASSERT_TRUE(crcs.empty());
+}
@@ -54,6 +54,16 @@ DEFINE_string(snap_db_path, "", "snapshot db path");
 DEFINE_string(peer_addrs, "", "peer address");
 DEFINE_string(log_file_path, "", "log file path");
 DEFINE_string(monitor_addrs, "", "monitor address");
+DEFINE_string(read_mode, "safe", "read mode, safe (read index) or lease");
+DEFINE_int32(clock_drift_bound_ms, 100, "clock drift bound of leader lease");
+DEFINE_int32(ae_max_count, 100, "max entries of one append entries request");
+DEFINE_int32(ae_max_size, 1 << 20, "max bytes of one append entries request");
+DEFINE_int32(raft_groups, 1, "raft groups hosted, >1 rejects member changes");
+DEFINE_bool(log_gc_async, false, "delete compacted log entries in background");
+DEFINE_string(log_engine, "rocksdb", "raft log engine, rocksdb or segment");
+DEFINE_string(log_compress, "none", "log payload codec, none, lz4 or zstd");
+DEFINE_string(log_db_options, "", "rocksdb options of the log entry cf");
+DEFINE_int32(apply_workers, 1, "threads applying the entries of a group");
 
 /**
  * @brief
@@ -78,6 +88,18 @@ int main(int argc, char* argv[]) {
   options_.snap_db_path = FLAGS_snap_db_path;
   options_.peer_addrs = FLAGS_peer_addrs;
   options_.monitor_addrs = FLAGS_monitor_addrs;
+  options_.read_mode = FLAGS_read_mode == "lease"
+                           ? ReadModeEnum::ReadOnlyLeaseBased
+                           : ReadModeEnum::ReadOnlySafe;
+  options_.clock_drift_bound_ms = FLAGS_clock_drift_bound_ms;
+  options_.ae_max_count = FLAGS_ae_max_count;
+  options_.ae_max_size = FLAGS_ae_max_size;
+  options_.raft_groups = FLAGS_raft_groups;
+  options_.log_gc_async = FLAGS_log_gc_async;
+  options_.log_engine = FLAGS_log_engine;
+  options_.log_compress = FLAGS_log_compress;
+  options_.log_db_options = FLAGS_log_db_options;
+  options_.apply_workers = FLAGS_apply_workers;
   std::string   log_file_path = FLAGS_log_file_path;
   ERaftKvServer server(options_);
 
@@ -28,6 +28,7 @@ static const char* ERaftKv_method_names[] = {
   "/eraftkv.ERaftKv/PutSSTFile",
   "/eraftkv.ERaftKv/ProcessRWOperation",
   "/eraftkv.ERaftKv/ClusterConfigChange",
+  "/eraftkv.ERaftKv/ReadIndex",
 };
 
 std::unique_ptr< ERaftKv::Stub> ERaftKv::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -43,6 +44,7 @@ ERaftKv::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel)
   , rpcmethod_PutSSTFile_(ERaftKv_method_names[3], ::grpc::internal::RpcMethod::CLIENT_STREAMING, channel)
   , rpcmethod_ProcessRWOperation_(ERaftKv_method_names[4], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_ClusterConfigChange_(ERaftKv_method_names[5], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_ReadIndex_(ERaftKv_method_names[6], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   {}
 
 ::grpc::Status ERaftKv::Stub::RequestVote(::grpc::ClientContext* context, const ::eraftkv::RequestVoteReq& request, ::eraftkv::RequestVoteResp* response) {
@@ -201,6 +203,34 @@ void ERaftKv::Stub::experimental_async::ClusterConfigChange(::grpc::ClientContex
   return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::eraftkv::ClusterConfigChangeResp>::Create(channel_.get(), cq, rpcmethod_ClusterConfigChange_, context, request, false);
 }
 
+::grpc::Status ERaftKv::Stub::ReadIndex(::grpc::ClientContext* context, const ::eraftkv::ReadIndexReq& request, ::eraftkv::ReadIndexResp* response) {
+  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_ReadIndex_, context, request, response);
+}
+
+void ERaftKv::Stub::experimental_async::ReadIndex(::grpc::ClientContext* context, const ::eraftkv::ReadIndexReq* request, ::eraftkv::ReadIndexResp* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_ReadIndex_, context, request, response, std::move(f));
+}
+
+void ERaftKv::Stub::experimental_async::ReadIndex(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::eraftkv::ReadIndexResp* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_ReadIndex_, context, request, response, std::move(f));
+}
+
+void ERaftKv::Stub::experimental_async::ReadIndex(::grpc::ClientContext* context, const ::eraftkv::ReadIndexReq* request, ::eraftkv::ReadIndexResp* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_ReadIndex_, context, request, response, reactor);
+}
+
+void ERaftKv::Stub::experimental_async::ReadIndex(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::eraftkv::ReadIndexResp* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_ReadIndex_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::eraftkv::ReadIndexResp>* ERaftKv::Stub::AsyncReadIndexRaw(::grpc::ClientContext* context, const ::eraftkv::ReadIndexReq& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::eraftkv::ReadIndexResp>::Create(channel_.get(), cq, rpcmethod_ReadIndex_, context, request, true);
+}
+
+::grpc::ClientAsyncResponseReader< ::eraftkv::ReadIndexResp>* ERaftKv::Stub::PrepareAsyncReadIndexRaw(::grpc::ClientContext* context, const ::eraftkv::ReadIndexReq& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::eraftkv::ReadIndexResp>::Create(channel_.get(), cq, rpcmethod_ReadIndex_, context, request, false);
+}
+
 ERaftKv::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       ERaftKv_method_names[0],
@@ -232,6 +262,11 @@ ERaftKv::Service::Service() {
       ::grpc::internal::RpcMethod::NORMAL_RPC,
       new ::grpc::internal::RpcMethodHandler< ERaftKv::Service, ::eraftkv::ClusterConfigChangeReq, ::eraftkv::ClusterConfigChangeResp>(
           std::mem_fn(&ERaftKv::Service::ClusterConfigChange), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ERaftKv_method_names[6],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< ERaftKv::Service, ::eraftkv::ReadIndexReq, ::eraftkv::ReadIndexResp>(
+          std::mem_fn(&ERaftKv::Service::ReadIndex), this)));
 }
 
 ERaftKv::Service::~Service() {
@@ -279,6 +314,13 @@ ERaftKv::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status ERaftKv::Service::ReadIndex(::grpc::ServerContext* context, const ::eraftkv::ReadIndexReq* request, ::eraftkv::ReadIndexResp* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace eraftkv
 
@@ -88,6 +88,14 @@ class SSTFileContentDefaultTypeInternal {
  public:
   ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<SSTFileContent> _instance;
 } _SSTFileContent_default_instance_;
+class ReadIndexReqDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<ReadIndexReq> _instance;
+} _ReadIndexReq_default_instance_;
+class ReadIndexRespDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<ReadIndexResp> _instance;
+} _ReadIndexResp_default_instance_;
 }  // namespace eraftkv
 static void InitDefaultsscc_info_AppendEntriesReq_eraftkv_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -207,6 +215,34 @@ static void InitDefaultsscc_info_KvOpPair_eraftkv_2eproto() {
 ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_KvOpPair_eraftkv_2eproto =
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_KvOpPair_eraftkv_2eproto}, {}};
 
+static void InitDefaultsscc_info_ReadIndexReq_eraftkv_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::eraftkv::_ReadIndexReq_default_instance_;
+    new (ptr) ::eraftkv::ReadIndexReq();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::eraftkv::ReadIndexReq::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_ReadIndexReq_eraftkv_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_ReadIndexReq_eraftkv_2eproto}, {}};
+
+static void InitDefaultsscc_info_ReadIndexResp_eraftkv_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::eraftkv::_ReadIndexResp_default_instance_;
+    new (ptr) ::eraftkv::ReadIndexResp();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::eraftkv::ReadIndexResp::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_ReadIndexResp_eraftkv_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_ReadIndexResp_eraftkv_2eproto}, {}};
+
 static void InitDefaultsscc_info_RequestVoteReq_eraftkv_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
@@ -335,8 +371,8 @@ static void InitDefaultsscc_info_SnapshotResp_eraftkv_2eproto() {
 ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_SnapshotResp_eraftkv_2eproto =
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_SnapshotResp_eraftkv_2eproto}, {}};
 
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_eraftkv_2eproto[17];
-static const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* file_level_enum_descriptors_eraftkv_2eproto[7];
+static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_eraftkv_2eproto[19];
+static const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* file_level_enum_descriptors_eraftkv_2eproto[8];
 static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_eraftkv_2eproto = nullptr;
 
 const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_eraftkv_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
@@ -370,6 +406,7 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_eraftkv_2eproto::offsets[] PRO
   PROTOBUF_FIELD_OFFSET(::eraftkv::Entry, e_type_),
   PROTOBUF_FIELD_OFFSET(::eraftkv::Entry, data_size_),
   PROTOBUF_FIELD_OFFSET(::eraftkv::Entry, data_),
+  PROTOBUF_FIELD_OFFSET(::eraftkv::Entry, compress_type_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::eraftkv::AppendEntriesReq, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -507,25 +544,43 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_eraftkv_2eproto::offsets[] PRO
   PROTOBUF_FIELD_OFFSET(::eraftkv::SSTFileContent, id_),
   PROTOBUF_FIELD_OFFSET(::eraftkv::SSTFileContent, name_),
   PROTOBUF_FIELD_OFFSET(::eraftkv::SSTFileContent, content_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexReq, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexReq, from_id_),
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexReq, term_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexResp, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexResp, success_),
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexResp, read_index_),
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexResp, term_),
+  PROTOBUF_FIELD_OFFSET(::eraftkv::ReadIndexResp, leader_id_),
 };
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::eraftkv::RequestVoteReq)},
   { 10, -1, sizeof(::eraftkv::RequestVoteResp)},
   { 20, -1, sizeof(::eraftkv::Entry)},
-  { 30, -1, sizeof(::eraftkv::AppendEntriesReq)},
-  { 43, -1, sizeof(::eraftkv::AppendEntriesResp)},
-  { 54, -1, sizeof(::eraftkv::SnapshotReq)},
-  { 67, -1, sizeof(::eraftkv::SnapshotResp)},
-  { 77, -1, sizeof(::eraftkv::Slot)},
-  { 85, -1, sizeof(::eraftkv::Server)},
-  { 93, -1, sizeof(::eraftkv::ShardGroup)},
-  { 102, -1, sizeof(::eraftkv::ClusterConfigChangeReq)},
-  { 116, -1, sizeof(::eraftkv::ClusterConfigChangeResp)},
-  { 126, -1, sizeof(::eraftkv::KvOpPair)},
-  { 136, -1, sizeof(::eraftkv::ClientOperationReq)},
-  { 145, -1, sizeof(::eraftkv::ClientOperationResp)},
-  { 153, -1, sizeof(::eraftkv::SSTFileId)},
-  { 159, -1, sizeof(::eraftkv::SSTFileContent)},
+  { 31, -1, sizeof(::eraftkv::AppendEntriesReq)},
+  { 44, -1, sizeof(::eraftkv::AppendEntriesResp)},
+  { 55, -1, sizeof(::eraftkv::SnapshotReq)},
+  { 68, -1, sizeof(::eraftkv::SnapshotResp)},
+  { 78, -1, sizeof(::eraftkv::Slot)},
+  { 86, -1, sizeof(::eraftkv::Server)},
+  { 94, -1, sizeof(::eraftkv::ShardGroup)},
+  { 103, -1, sizeof(::eraftkv::ClusterConfigChangeReq)},
+  { 117, -1, sizeof(::eraftkv::ClusterConfigChangeResp)},
+  { 127, -1, sizeof(::eraftkv::KvOpPair)},
+  { 137, -1, sizeof(::eraftkv::ClientOperationReq)},
+  { 146, -1, sizeof(::eraftkv::ClientOperationResp)},
+  { 154, -1, sizeof(::eraftkv::SSTFileId)},
+  { 160, -1, sizeof(::eraftkv::SSTFileContent)},
+  { 168, -1, sizeof(::eraftkv::ReadIndexReq)},
+  { 175, -1, sizeof(::eraftkv::ReadIndexResp)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -546,6 +601,8 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::eraftkv::_ClientOperationResp_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::eraftkv::_SSTFileId_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::eraftkv::_SSTFileContent_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::eraftkv::_ReadIndexReq_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::eraftkv::_ReadIndexResp_default_instance_),
 };
 
 const char descriptor_table_protodef_eraftkv_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
@@ -555,83 +612,91 @@ const char descriptor_table_protodef_eraftkv_2eproto[] PROTOBUF_SECTION_VARIABLE
   "\n\rlast_log_term\030\005 \001(\003\"o\n\017RequestVoteResp"
   "\022\017\n\007prevote\030\001 \001(\010\022\024\n\014request_term\030\002 \001(\003\022"
   "\014\n\004term\030\003 \001(\003\022\024\n\014vote_granted\030\004 \001(\010\022\021\n\tl"
-  "eader_id\030\005 \001(\003\"f\n\005Entry\022\014\n\004term\030\001 \001(\003\022\n\n"
-  "\002id\030\002 \001(\003\022\"\n\006e_type\030\003 \001(\0162\022.eraftkv.Entr"
-  "yType\022\021\n\tdata_size\030\004 \001(\003\022\014\n\004data\030\005 \001(\014\"\307"
-  "\001\n\020AppendEntriesReq\022\021\n\tleader_id\030\001 \001(\003\022\025"
-  "\n\rmessage_index\030\002 \001(\003\022\014\n\004term\030\003 \001(\003\022\026\n\016p"
-  "rev_log_index\030\004 \001(\003\022\025\n\rprev_log_term\030\005 \001"
-  "(\003\022\025\n\rleader_commit\030\006 \001(\003\022\024\n\014is_heartbea"
-  "t\030\007 \001(\010\022\037\n\007entries\030\010 \003(\0132\016.eraftkv.Entry"
-  "\"\217\001\n\021AppendEntriesResp\022\025\n\rmessage_token\030"
-  "\001 \001(\t\022\014\n\004term\030\002 \001(\003\022\017\n\007success\030\003 \001(\010\022\025\n\r"
-  "current_index\030\004 \001(\003\022\026\n\016conflict_index\030\005 "
-  "\001(\003\022\025\n\rconflict_term\030\006 \001(\003\"\252\001\n\013SnapshotR"
-  "eq\022\014\n\004term\030\001 \001(\003\022\021\n\tleader_id\030\002 \001(\003\022\025\n\rm"
-  "essage_index\030\003 \001(\t\022\033\n\023last_included_inde"
-  "x\030\004 \001(\003\022\032\n\022last_included_term\030\005 \001(\003\022\016\n\006o"
-  "ffset\030\006 \001(\003\022\014\n\004data\030\007 \001(\014\022\014\n\004done\030\010 \001(\010\""
-  "k\n\014SnapshotResp\022\014\n\004term\030\001 \001(\003\022\025\n\rmessage"
-  "_index\030\002 \001(\t\022\016\n\006offset\030\003 \001(\003\022\017\n\007success\030"
-  "\004 \001(\010\022\025\n\ris_last_chunk\030\005 \001(\010\"X\n\004Slot\022\n\n\002"
-  "id\030\001 \001(\003\022(\n\013slot_status\030\002 \001(\0162\023.eraftkv."
-  "SlotStatus\022\032\n\022status_modify_time\030\003 \001(\003\"S"
-  "\n\006Server\022\n\n\002id\030\001 \001(\003\022\017\n\007address\030\002 \001(\t\022,\n"
-  "\rserver_status\030\003 \001(\0162\025.eraftkv.ServerSta"
-  "tus\"k\n\nShardGroup\022\n\n\002id\030\001 \001(\003\022\034\n\005slots\030\002"
-  " \003(\0132\r.eraftkv.Slot\022 \n\007servers\030\003 \003(\0132\017.e"
-  "raftkv.Server\022\021\n\tleader_id\030\004 \001(\003\"\246\002\n\026Clu"
-  "sterConfigChangeReq\022(\n\013change_type\030\001 \001(\016"
-  "2\023.eraftkv.ChangeType\0225\n\022handle_server_t"
-  "ype\030\002 \001(\0162\031.eraftkv.HandleServerType\022\020\n\010"
-  "shard_id\030\003 \001(\003\022\037\n\006server\030\004 \001(\0132\017.eraftkv"
-  ".Server\022\026\n\016config_version\030\005 \001(\003\022\017\n\007op_si"
-  "gn\030\006 \001(\003\022\022\n\ncommand_id\030\007 \001(\003\022\021\n\tclient_i"
-  "d\030\010 \001(\t\022(\n\013shard_group\030\t \001(\0132\023.eraftkv.S"
-  "hardGroup\"\251\001\n\027ClusterConfigChangeResp\022\017\n"
-  "\007success\030\001 \001(\010\022(\n\013shard_group\030\002 \003(\0132\023.er"
-  "aftkv.ShardGroup\022\026\n\016config_version\030\003 \001(\003"
-  "\022&\n\nerror_code\030\004 \001(\0162\022.eraftkv.ErrorCode"
-  "\022\023\n\013leader_addr\030\005 \001(\003\"p\n\010KvOpPair\022&\n\007op_"
-  "type\030\001 \001(\0162\025.eraftkv.ClientOpType\022\013\n\003key"
-  "\030\002 \001(\t\022\r\n\005value\030\003 \001(\t\022\017\n\007success\030\004 \001(\010\022\017"
-  "\n\007op_sign\030\005 \001(\003\"q\n\022ClientOperationReq\022\024\n"
-  "\014op_timestamp\030\001 \001(\004\022\021\n\tclient_id\030\002 \001(\t\022\022"
-  "\n\ncommand_id\030\003 \001(\003\022\036\n\003kvs\030\004 \003(\0132\021.eraftk"
-  "v.KvOpPair\"r\n\023ClientOperationResp\022\036\n\003ops"
-  "\030\001 \003(\0132\021.eraftkv.KvOpPair\022&\n\nerror_code\030"
-  "\002 \001(\0162\022.eraftkv.ErrorCode\022\023\n\013leader_addr"
-  "\030\003 \001(\003\"\027\n\tSSTFileId\022\n\n\002id\030\001 \001(\005\";\n\016SSTFi"
-  "leContent\022\n\n\002id\030\001 \001(\005\022\014\n\004name\030\002 \001(\t\022\017\n\007c"
-  "ontent\030\003 \001(\014*h\n\tErrorCode\022\033\n\027REQUEST_NOT"
-  "_LEADER_NODE\020\000\022\020\n\014NODE_IS_DOWN\020\001\022\023\n\017REQU"
-  "EST_TIMEOUT\020\002\022\027\n\023NODE_IS_SNAPSHOTING\020\003*1"
-  "\n\tEntryType\022\n\n\006Normal\020\000\022\016\n\nConfChange\020\001\022"
-  "\010\n\004NoOp\020\002*A\n\nSlotStatus\022\013\n\007Running\020\000\022\r\n\t"
-  "Migrating\020\001\022\r\n\tImporting\020\002\022\010\n\004Init\020\003* \n\014"
-  "ServerStatus\022\006\n\002Up\020\000\022\010\n\004Down\020\001*\216\001\n\nChang"
-  "eType\022\017\n\013ClusterInit\020\000\022\r\n\tShardJoin\020\001\022\016\n"
-  "\nShardLeave\020\002\022\017\n\013ShardsQuery\020\003\022\014\n\010SlotMo"
-  "ve\020\004\022\016\n\nServerJoin\020\005\022\017\n\013ServerLeave\020\006\022\020\n"
-  "\014MembersQuery\020\007*2\n\020HandleServerType\022\016\n\nM"
-  "etaServer\020\000\022\016\n\nDataServer\020\001*=\n\014ClientOpT"
-  "ype\022\010\n\004Noop\020\000\022\007\n\003Put\020\001\022\007\n\003Get\020\002\022\007\n\003Del\020\003"
-  "\022\010\n\004Scan\020\0042\264\003\n\007ERaftKv\022@\n\013RequestVote\022\027."
-  "eraftkv.RequestVoteReq\032\030.eraftkv.Request"
-  "VoteResp\022F\n\rAppendEntries\022\031.eraftkv.Appe"
-  "ndEntriesReq\032\032.eraftkv.AppendEntriesResp"
-  "\0227\n\010Snapshot\022\024.eraftkv.SnapshotReq\032\025.era"
-  "ftkv.SnapshotResp\022;\n\nPutSSTFile\022\027.eraftk"
-  "v.SSTFileContent\032\022.eraftkv.SSTFileId(\001\022O"
-  "\n\022ProcessRWOperation\022\033.eraftkv.ClientOpe"
-  "rationReq\032\034.eraftkv.ClientOperationResp\022"
-  "X\n\023ClusterConfigChange\022\037.eraftkv.Cluster"
-  "ConfigChangeReq\032 .eraftkv.ClusterConfigC"
-  "hangeRespb\006proto3"
+  "eader_id\030\005 \001(\003\"\224\001\n\005Entry\022\014\n\004term\030\001 \001(\003\022\n"
+  "\n\002id\030\002 \001(\003\022\"\n\006e_type\030\003 \001(\0162\022.eraftkv.Ent"
+  "ryType\022\021\n\tdata_size\030\004 \001(\003\022\014\n\004data\030\005 \001(\014\022"
+  ",\n\rcompress_type\030\006 \001(\0162\025.eraftkv.Compres"
+  "sType\"\307\001\n\020AppendEntriesReq\022\021\n\tleader_id\030"
+  "\001 \001(\003\022\025\n\rmessage_index\030\002 \001(\003\022\014\n\004term\030\003 \001"
+  "(\003\022\026\n\016prev_log_index\030\004 \001(\003\022\025\n\rprev_log_t"
+  "erm\030\005 \001(\003\022\025\n\rleader_commit\030\006 \001(\003\022\024\n\014is_h"
+  "eartbeat\030\007 \001(\010\022\037\n\007entries\030\010 \003(\0132\016.eraftk"
+  "v.Entry\"\217\001\n\021AppendEntriesResp\022\025\n\rmessage"
+  "_token\030\001 \001(\t\022\014\n\004term\030\002 \001(\003\022\017\n\007success\030\003 "
+  "\001(\010\022\025\n\rcurrent_index\030\004 \001(\003\022\026\n\016conflict_i"
+  "ndex\030\005 \001(\003\022\025\n\rconflict_term\030\006 \001(\003\"\252\001\n\013Sn"
+  "apshotReq\022\014\n\004term\030\001 \001(\003\022\021\n\tleader_id\030\002 \001"
+  "(\003\022\025\n\rmessage_index\030\003 \001(\t\022\033\n\023last_includ"
+  "ed_index\030\004 \001(\003\022\032\n\022last_included_term\030\005 \001"
+  "(\003\022\016\n\006offset\030\006 \001(\003\022\014\n\004data\030\007 \001(\014\022\014\n\004done"
+  "\030\010 \001(\010\"k\n\014SnapshotResp\022\014\n\004term\030\001 \001(\003\022\025\n\r"
+  "message_index\030\002 \001(\t\022\016\n\006offset\030\003 \001(\003\022\017\n\007s"
+  "uccess\030\004 \001(\010\022\025\n\ris_last_chunk\030\005 \001(\010\"X\n\004S"
+  "lot\022\n\n\002id\030\001 \001(\003\022(\n\013slot_status\030\002 \001(\0162\023.e"
+  "raftkv.SlotStatus\022\032\n\022status_modify_time\030"
+  "\003 \001(\003\"S\n\006Server\022\n\n\002id\030\001 \001(\003\022\017\n\007address\030\002"
+  " \001(\t\022,\n\rserver_status\030\003 \001(\0162\025.eraftkv.Se"
+  "rverStatus\"k\n\nShardGroup\022\n\n\002id\030\001 \001(\003\022\034\n\005"
+  "slots\030\002 \003(\0132\r.eraftkv.Slot\022 \n\007servers\030\003 "
+  "\003(\0132\017.eraftkv.Server\022\021\n\tleader_id\030\004 \001(\003\""
+  "\246\002\n\026ClusterConfigChangeReq\022(\n\013change_typ"
+  "e\030\001 \001(\0162\023.eraftkv.ChangeType\0225\n\022handle_s"
+  "erver_type\030\002 \001(\0162\031.eraftkv.HandleServerT"
+  "ype\022\020\n\010shard_id\030\003 \001(\003\022\037\n\006server\030\004 \001(\0132\017."
+  "eraftkv.Server\022\026\n\016config_version\030\005 \001(\003\022\017"
+  "\n\007op_sign\030\006 \001(\003\022\022\n\ncommand_id\030\007 \001(\003\022\021\n\tc"
+  "lient_id\030\010 \001(\t\022(\n\013shard_group\030\t \001(\0132\023.er"
+  "aftkv.ShardGroup\"\251\001\n\027ClusterConfigChange"
+  "Resp\022\017\n\007success\030\001 \001(\010\022(\n\013shard_group\030\002 \003"
+  "(\0132\023.eraftkv.ShardGroup\022\026\n\016config_versio"
+  "n\030\003 \001(\003\022&\n\nerror_code\030\004 \001(\0162\022.eraftkv.Er"
+  "rorCode\022\023\n\013leader_addr\030\005 \001(\003\"p\n\010KvOpPair"
+  "\022&\n\007op_type\030\001 \001(\0162\025.eraftkv.ClientOpType"
+  "\022\013\n\003key\030\002 \001(\t\022\r\n\005value\030\003 \001(\t\022\017\n\007success\030"
+  "\004 \001(\010\022\017\n\007op_sign\030\005 \001(\003\"q\n\022ClientOperatio"
+  "nReq\022\024\n\014op_timestamp\030\001 \001(\004\022\021\n\tclient_id\030"
+  "\002 \001(\t\022\022\n\ncommand_id\030\003 \001(\003\022\036\n\003kvs\030\004 \003(\0132\021"
+  ".eraftkv.KvOpPair\"r\n\023ClientOperationResp"
+  "\022\036\n\003ops\030\001 \003(\0132\021.eraftkv.KvOpPair\022&\n\nerro"
+  "r_code\030\002 \001(\0162\022.eraftkv.ErrorCode\022\023\n\013lead"
+  "er_addr\030\003 \001(\003\"\027\n\tSSTFileId\022\n\n\002id\030\001 \001(\005\";"
+  "\n\016SSTFileContent\022\n\n\002id\030\001 \001(\005\022\014\n\004name\030\002 \001"
+  "(\t\022\017\n\007content\030\003 \001(\014\"-\n\014ReadIndexReq\022\017\n\007f"
+  "rom_id\030\001 \001(\003\022\014\n\004term\030\002 \001(\003\"U\n\rReadIndexR"
+  "esp\022\017\n\007success\030\001 \001(\010\022\022\n\nread_index\030\002 \001(\003"
+  "\022\014\n\004term\030\003 \001(\003\022\021\n\tleader_id\030\004 \001(\003*h\n\tErr"
+  "orCode\022\033\n\027REQUEST_NOT_LEADER_NODE\020\000\022\020\n\014N"
+  "ODE_IS_DOWN\020\001\022\023\n\017REQUEST_TIMEOUT\020\002\022\027\n\023NO"
+  "DE_IS_SNAPSHOTING\020\003*1\n\tEntryType\022\n\n\006Norm"
+  "al\020\000\022\016\n\nConfChange\020\001\022\010\n\004NoOp\020\002*A\n\014Compre"
+  "ssType\022\016\n\nNoCompress\020\000\022\017\n\013LZ4Compress\020\001\022"
+  "\020\n\014ZstdCompress\020\002*A\n\nSlotStatus\022\013\n\007Runni"
+  "ng\020\000\022\r\n\tMigrating\020\001\022\r\n\tImporting\020\002\022\010\n\004In"
+  "it\020\003* \n\014ServerStatus\022\006\n\002Up\020\000\022\010\n\004Down\020\001*\216"
+  "\001\n\nChangeType\022\017\n\013ClusterInit\020\000\022\r\n\tShardJ"
+  "oin\020\001\022\016\n\nShardLeave\020\002\022\017\n\013ShardsQuery\020\003\022\014"
+  "\n\010SlotMove\020\004\022\016\n\nServerJoin\020\005\022\017\n\013ServerLe"
+  "ave\020\006\022\020\n\014MembersQuery\020\007*2\n\020HandleServerT"
+  "ype\022\016\n\nMetaServer\020\000\022\016\n\nDataServer\020\001*=\n\014C"
+  "lientOpType\022\010\n\004Noop\020\000\022\007\n\003Put\020\001\022\007\n\003Get\020\002\022"
+  "\007\n\003Del\020\003\022\010\n\004Scan\020\0042\360\003\n\007ERaftKv\022@\n\013Reques"
+  "tVote\022\027.eraftkv.RequestVoteReq\032\030.eraftkv"
+  ".RequestVoteResp\022F\n\rAppendEntries\022\031.eraf"
+  "tkv.AppendEntriesReq\032\032.eraftkv.AppendEnt"
+  "riesResp\0227\n\010Snapshot\022\024.eraftkv.SnapshotR"
+  "eq\032\025.eraftkv.SnapshotResp\022;\n\nPutSSTFile\022"
+  "\027.eraftkv.SSTFileContent\032\022.eraftkv.SSTFi"
+  "leId(\001\022O\n\022ProcessRWOperation\022\033.eraftkv.C"
+  "lientOperationReq\032\034.eraftkv.ClientOperat"
+  "ionResp\022X\n\023ClusterConfigChange\022\037.eraftkv"
+  ".ClusterConfigChangeReq\032 .eraftkv.Cluste"
+  "rConfigChangeResp\022:\n\tReadIndex\022\025.eraftkv"
+  ".ReadIndexReq\032\026.eraftkv.ReadIndexRespb\006p"
+  "roto3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_eraftkv_2eproto_deps[1] = {
 };
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_eraftkv_2eproto_sccs[17] = {
+static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_eraftkv_2eproto_sccs[19] = {
   &scc_info_AppendEntriesReq_eraftkv_2eproto.base,
   &scc_info_AppendEntriesResp_eraftkv_2eproto.base,
   &scc_info_ClientOperationReq_eraftkv_2eproto.base,
@@ -640,6 +705,8 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_era
   &scc_info_ClusterConfigChangeResp_eraftkv_2eproto.base,
   &scc_info_Entry_eraftkv_2eproto.base,
   &scc_info_KvOpPair_eraftkv_2eproto.base,
+  &scc_info_ReadIndexReq_eraftkv_2eproto.base,
+  &scc_info_ReadIndexResp_eraftkv_2eproto.base,
   &scc_info_RequestVoteReq_eraftkv_2eproto.base,
   &scc_info_RequestVoteResp_eraftkv_2eproto.base,
   &scc_info_SSTFileContent_eraftkv_2eproto.base,
@@ -653,10 +720,10 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_era
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_eraftkv_2eproto_once;
 static bool descriptor_table_eraftkv_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_eraftkv_2eproto = {
-  &descriptor_table_eraftkv_2eproto_initialized, descriptor_table_protodef_eraftkv_2eproto, "eraftkv.proto", 3137,
-  &descriptor_table_eraftkv_2eproto_once, descriptor_table_eraftkv_2eproto_sccs, descriptor_table_eraftkv_2eproto_deps, 17, 0,
+  &descriptor_table_eraftkv_2eproto_initialized, descriptor_table_protodef_eraftkv_2eproto, "eraftkv.proto", 3445,
+  &descriptor_table_eraftkv_2eproto_once, descriptor_table_eraftkv_2eproto_sccs, descriptor_table_eraftkv_2eproto_deps, 19, 0,
   schemas, file_default_instances, TableStruct_eraftkv_2eproto::offsets,
-  file_level_metadata_eraftkv_2eproto, 17, file_level_enum_descriptors_eraftkv_2eproto, file_level_service_descriptors_eraftkv_2eproto,
+  file_level_metadata_eraftkv_2eproto, 19, file_level_enum_descriptors_eraftkv_2eproto, file_level_service_descriptors_eraftkv_2eproto,
 };
 
 // Force running AddDescriptors() at dynamic initialization time.
@@ -693,10 +760,25 @@ bool EntryType_IsValid(int value) {
   }
 }
 
-const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SlotStatus_descriptor() {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* CompressType_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
   return file_level_enum_descriptors_eraftkv_2eproto[2];
 }
+bool CompressType_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SlotStatus_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
+  return file_level_enum_descriptors_eraftkv_2eproto[3];
+}
 bool SlotStatus_IsValid(int value) {
   switch (value) {
     case 0:
@@ -711,7 +793,7 @@ bool SlotStatus_IsValid(int value) {
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ServerStatus_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
-  return file_level_enum_descriptors_eraftkv_2eproto[3];
+  return file_level_enum_descriptors_eraftkv_2eproto[4];
 }
 bool ServerStatus_IsValid(int value) {
   switch (value) {
@@ -725,7 +807,7 @@ bool ServerStatus_IsValid(int value) {
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ChangeType_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
-  return file_level_enum_descriptors_eraftkv_2eproto[4];
+  return file_level_enum_descriptors_eraftkv_2eproto[5];
 }
 bool ChangeType_IsValid(int value) {
   switch (value) {
@@ -745,7 +827,7 @@ bool ChangeType_IsValid(int value) {
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* HandleServerType_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
-  return file_level_enum_descriptors_eraftkv_2eproto[5];
+  return file_level_enum_descriptors_eraftkv_2eproto[6];
 }
 bool HandleServerType_IsValid(int value) {
   switch (value) {
@@ -759,7 +841,7 @@ bool HandleServerType_IsValid(int value) {
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ClientOpType_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_eraftkv_2eproto);
-  return file_level_enum_descriptors_eraftkv_2eproto[6];
+  return file_level_enum_descriptors_eraftkv_2eproto[7];
 }
 bool ClientOpType_IsValid(int value) {
   switch (value) {
@@ -1367,8 +1449,8 @@ Entry::Entry(const Entry& from)
     data_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.data_);
   }
   ::memcpy(&term_, &from.term_,
-    static_cast<size_t>(reinterpret_cast<char*>(&e_type_) -
-    reinterpret_cast<char*>(&term_)) + sizeof(e_type_));
+    static_cast<size_t>(reinterpret_cast<char*>(&compress_type_) -
+    reinterpret_cast<char*>(&term_)) + sizeof(compress_type_));
   // @@protoc_insertion_point(copy_constructor:eraftkv.Entry)
 }
 
@@ -1376,8 +1458,8 @@ void Entry::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_Entry_eraftkv_2eproto.base);
   data_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&term_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&e_type_) -
-      reinterpret_cast<char*>(&term_)) + sizeof(e_type_));
+      reinterpret_cast<char*>(&compress_type_) -
+      reinterpret_cast<char*>(&term_)) + sizeof(compress_type_));
 }
 
 Entry::~Entry() {
@@ -1406,8 +1488,8 @@ void Entry::Clear() {
 
   data_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&term_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&e_type_) -
-      reinterpret_cast<char*>(&term_)) + sizeof(e_type_));
+      reinterpret_cast<char*>(&compress_type_) -
+      reinterpret_cast<char*>(&term_)) + sizeof(compress_type_));
   _internal_metadata_.Clear();
 }
 
@@ -1455,6 +1537,14 @@ const char* Entry::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::inte
           CHK_(ptr);
         } else goto handle_unusual;
         continue;
+      // .eraftkv.CompressType compress_type = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 48)) {
+          ::PROTOBUF_NAMESPACE_ID::uint64 val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+          _internal_set_compress_type(static_cast<::eraftkv::CompressType>(val));
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -1512,6 +1602,13 @@ failure:
         5, this->_internal_data(), target);
   }
 
+  // .eraftkv.CompressType compress_type = 6;
+  if (this->compress_type() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteEnumToArray(
+      6, this->_internal_compress_type(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -1562,6 +1659,12 @@ size_t Entry::ByteSizeLong() const {
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::EnumSize(this->_internal_e_type());
   }
 
+  // .eraftkv.CompressType compress_type = 6;
+  if (this->compress_type() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::EnumSize(this->_internal_compress_type());
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
         _internal_metadata_, total_size, &_cached_size_);
@@ -1609,6 +1712,9 @@ void Entry::MergeFrom(const Entry& from) {
   if (from.e_type() != 0) {
     _internal_set_e_type(from._internal_e_type());
   }
+  if (from.compress_type() != 0) {
+    _internal_set_compress_type(from._internal_compress_type());
+  }
 }
 
 void Entry::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -1638,6 +1744,7 @@ void Entry::InternalSwap(Entry* other) {
   swap(id_, other->id_);
   swap(data_size_, other->data_size_);
   swap(e_type_, other->e_type_);
+  swap(compress_type_, other->compress_type_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Entry::GetMetadata() const {
@@ -5833,6 +5940,484 @@ void SSTFileContent::InternalSwap(SSTFileContent* other) {
 }
 
 
+// ===================================================================
+
+void ReadIndexReq::InitAsDefaultInstance() {
+}
+class ReadIndexReq::_Internal {
+ public:
+};
+
+ReadIndexReq::ReadIndexReq()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:eraftkv.ReadIndexReq)
+}
+ReadIndexReq::ReadIndexReq(const ReadIndexReq& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::memcpy(&from_id_, &from.from_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&term_) -
+    reinterpret_cast<char*>(&from_id_)) + sizeof(term_));
+  // @@protoc_insertion_point(copy_constructor:eraftkv.ReadIndexReq)
+}
+
+void ReadIndexReq::SharedCtor() {
+  ::memset(&from_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&term_) -
+      reinterpret_cast<char*>(&from_id_)) + sizeof(term_));
+}
+
+ReadIndexReq::~ReadIndexReq() {
+  // @@protoc_insertion_point(destructor:eraftkv.ReadIndexReq)
+  SharedDtor();
+}
+
+void ReadIndexReq::SharedDtor() {
+}
+
+void ReadIndexReq::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ReadIndexReq& ReadIndexReq::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_ReadIndexReq_eraftkv_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void ReadIndexReq::Clear() {
+// @@protoc_insertion_point(message_clear_start:eraftkv.ReadIndexReq)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&from_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&term_) -
+      reinterpret_cast<char*>(&from_id_)) + sizeof(term_));
+  _internal_metadata_.Clear();
+}
+
+const char* ReadIndexReq::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // int64 from_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
+          from_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 term = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
+          term_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* ReadIndexReq::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:eraftkv.ReadIndexReq)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // int64 from_id = 1;
+  if (this->from_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(1, this->_internal_from_id(), target);
+  }
+
+  // int64 term = 2;
+  if (this->term() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(2, this->_internal_term(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:eraftkv.ReadIndexReq)
+  return target;
+}
+
+size_t ReadIndexReq::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:eraftkv.ReadIndexReq)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // int64 from_id = 1;
+  if (this->from_id() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->_internal_from_id());
+  }
+
+  // int64 term = 2;
+  if (this->term() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->_internal_term());
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void ReadIndexReq::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:eraftkv.ReadIndexReq)
+  GOOGLE_DCHECK_NE(&from, this);
+  const ReadIndexReq* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ReadIndexReq>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:eraftkv.ReadIndexReq)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:eraftkv.ReadIndexReq)
+    MergeFrom(*source);
+  }
+}
+
+void ReadIndexReq::MergeFrom(const ReadIndexReq& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:eraftkv.ReadIndexReq)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.from_id() != 0) {
+    _internal_set_from_id(from._internal_from_id());
+  }
+  if (from.term() != 0) {
+    _internal_set_term(from._internal_term());
+  }
+}
+
+void ReadIndexReq::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:eraftkv.ReadIndexReq)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void ReadIndexReq::CopyFrom(const ReadIndexReq& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:eraftkv.ReadIndexReq)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ReadIndexReq::IsInitialized() const {
+  return true;
+}
+
+void ReadIndexReq::InternalSwap(ReadIndexReq* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(from_id_, other->from_id_);
+  swap(term_, other->term_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ReadIndexReq::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+void ReadIndexResp::InitAsDefaultInstance() {
+}
+class ReadIndexResp::_Internal {
+ public:
+};
+
+ReadIndexResp::ReadIndexResp()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:eraftkv.ReadIndexResp)
+}
+ReadIndexResp::ReadIndexResp(const ReadIndexResp& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::memcpy(&read_index_, &from.read_index_,
+    static_cast<size_t>(reinterpret_cast<char*>(&success_) -
+    reinterpret_cast<char*>(&read_index_)) + sizeof(success_));
+  // @@protoc_insertion_point(copy_constructor:eraftkv.ReadIndexResp)
+}
+
+void ReadIndexResp::SharedCtor() {
+  ::memset(&read_index_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&success_) -
+      reinterpret_cast<char*>(&read_index_)) + sizeof(success_));
+}
+
+ReadIndexResp::~ReadIndexResp() {
+  // @@protoc_insertion_point(destructor:eraftkv.ReadIndexResp)
+  SharedDtor();
+}
+
+void ReadIndexResp::SharedDtor() {
+}
+
+void ReadIndexResp::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ReadIndexResp& ReadIndexResp::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_ReadIndexResp_eraftkv_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void ReadIndexResp::Clear() {
+// @@protoc_insertion_point(message_clear_start:eraftkv.ReadIndexResp)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&read_index_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&success_) -
+      reinterpret_cast<char*>(&read_index_)) + sizeof(success_));
+  _internal_metadata_.Clear();
+}
+
+const char* ReadIndexResp::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // bool success = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
+          success_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 read_index = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
+          read_index_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 term = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 24)) {
+          term_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 leader_id = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
+          leader_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* ReadIndexResp::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:eraftkv.ReadIndexResp)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // bool success = 1;
+  if (this->success() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(1, this->_internal_success(), target);
+  }
+
+  // int64 read_index = 2;
+  if (this->read_index() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(2, this->_internal_read_index(), target);
+  }
+
+  // int64 term = 3;
+  if (this->term() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(3, this->_internal_term(), target);
+  }
+
+  // int64 leader_id = 4;
+  if (this->leader_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(4, this->_internal_leader_id(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:eraftkv.ReadIndexResp)
+  return target;
+}
+
+size_t ReadIndexResp::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:eraftkv.ReadIndexResp)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // int64 read_index = 2;
+  if (this->read_index() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->_internal_read_index());
+  }
+
+  // int64 term = 3;
+  if (this->term() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->_internal_term());
+  }
+
+  // int64 leader_id = 4;
+  if (this->leader_id() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->_internal_leader_id());
+  }
+
+  // bool success = 1;
+  if (this->success() != 0) {
+    total_size += 1 + 1;
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void ReadIndexResp::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:eraftkv.ReadIndexResp)
+  GOOGLE_DCHECK_NE(&from, this);
+  const ReadIndexResp* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ReadIndexResp>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:eraftkv.ReadIndexResp)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:eraftkv.ReadIndexResp)
+    MergeFrom(*source);
+  }
+}
+
+void ReadIndexResp::MergeFrom(const ReadIndexResp& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:eraftkv.ReadIndexResp)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.read_index() != 0) {
+    _internal_set_read_index(from._internal_read_index());
+  }
+  if (from.term() != 0) {
+    _internal_set_term(from._internal_term());
+  }
+  if (from.leader_id() != 0) {
+    _internal_set_leader_id(from._internal_leader_id());
+  }
+  if (from.success() != 0) {
+    _internal_set_success(from._internal_success());
+  }
+}
+
+void ReadIndexResp::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:eraftkv.ReadIndexResp)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void ReadIndexResp::CopyFrom(const ReadIndexResp& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:eraftkv.ReadIndexResp)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ReadIndexResp::IsInitialized() const {
+  return true;
+}
+
+void ReadIndexResp::InternalSwap(ReadIndexResp* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(read_index_, other->read_index_);
+  swap(term_, other->term_);
+  swap(leader_id_, other->leader_id_);
+  swap(success_, other->success_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ReadIndexResp::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace eraftkv
 PROTOBUF_NAMESPACE_OPEN
@@ -5887,6 +6472,12 @@ template<> PROTOBUF_NOINLINE ::eraftkv::SSTFileId* Arena::CreateMaybeMessage< ::
 template<> PROTOBUF_NOINLINE ::eraftkv::SSTFileContent* Arena::CreateMaybeMessage< ::eraftkv::SSTFileContent >(Arena* arena) {
   return Arena::CreateInternal< ::eraftkv::SSTFileContent >(arena);
 }
+template<> PROTOBUF_NOINLINE ::eraftkv::ReadIndexReq* Arena::CreateMaybeMessage< ::eraftkv::ReadIndexReq >(Arena* arena) {
+  return Arena::CreateInternal< ::eraftkv::ReadIndexReq >(arena);
+}
+template<> PROTOBUF_NOINLINE ::eraftkv::ReadIndexResp* Arena::CreateMaybeMessage< ::eraftkv::ReadIndexResp >(Arena* arena) {
+  return Arena::CreateInternal< ::eraftkv::ReadIndexResp >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
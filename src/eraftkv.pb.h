@@ -48,7 +48,7 @@ struct TableStruct_eraftkv_2eproto {
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::AuxillaryParseTableField aux[]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[17]
+  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[19]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
   static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
@@ -80,6 +80,12 @@ extern EntryDefaultTypeInternal _Entry_default_instance_;
 class KvOpPair;
 class KvOpPairDefaultTypeInternal;
 extern KvOpPairDefaultTypeInternal _KvOpPair_default_instance_;
+class ReadIndexReq;
+class ReadIndexReqDefaultTypeInternal;
+extern ReadIndexReqDefaultTypeInternal _ReadIndexReq_default_instance_;
+class ReadIndexResp;
+class ReadIndexRespDefaultTypeInternal;
+extern ReadIndexRespDefaultTypeInternal _ReadIndexResp_default_instance_;
 class RequestVoteReq;
 class RequestVoteReqDefaultTypeInternal;
 extern RequestVoteReqDefaultTypeInternal _RequestVoteReq_default_instance_;
@@ -117,6 +123,8 @@ template<> ::eraftkv::ClusterConfigChangeReq* Arena::CreateMaybeMessage<::eraftk
 template<> ::eraftkv::ClusterConfigChangeResp* Arena::CreateMaybeMessage<::eraftkv::ClusterConfigChangeResp>(Arena*);
 template<> ::eraftkv::Entry* Arena::CreateMaybeMessage<::eraftkv::Entry>(Arena*);
 template<> ::eraftkv::KvOpPair* Arena::CreateMaybeMessage<::eraftkv::KvOpPair>(Arena*);
+template<> ::eraftkv::ReadIndexReq* Arena::CreateMaybeMessage<::eraftkv::ReadIndexReq>(Arena*);
+template<> ::eraftkv::ReadIndexResp* Arena::CreateMaybeMessage<::eraftkv::ReadIndexResp>(Arena*);
 template<> ::eraftkv::RequestVoteReq* Arena::CreateMaybeMessage<::eraftkv::RequestVoteReq>(Arena*);
 template<> ::eraftkv::RequestVoteResp* Arena::CreateMaybeMessage<::eraftkv::RequestVoteResp>(Arena*);
 template<> ::eraftkv::SSTFileContent* Arena::CreateMaybeMessage<::eraftkv::SSTFileContent>(Arena*);
@@ -182,6 +190,32 @@ inline bool EntryType_Parse(
   return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<EntryType>(
     EntryType_descriptor(), name, value);
 }
+enum CompressType : int {
+  NoCompress = 0,
+  LZ4Compress = 1,
+  ZstdCompress = 2,
+  CompressType_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<::PROTOBUF_NAMESPACE_ID::int32>::min(),
+  CompressType_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<::PROTOBUF_NAMESPACE_ID::int32>::max()
+};
+bool CompressType_IsValid(int value);
+constexpr CompressType CompressType_MIN = NoCompress;
+constexpr CompressType CompressType_MAX = ZstdCompress;
+constexpr int CompressType_ARRAYSIZE = CompressType_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* CompressType_descriptor();
+template<typename T>
+inline const std::string& CompressType_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, CompressType>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function CompressType_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    CompressType_descriptor(), enum_t_value);
+}
+inline bool CompressType_Parse(
+    const std::string& name, CompressType* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<CompressType>(
+    CompressType_descriptor(), name, value);
+}
 enum SlotStatus : int {
   Running = 0,
   Migrating = 1,
@@ -775,6 +809,7 @@ class Entry :
     kIdFieldNumber = 2,
     kDataSizeFieldNumber = 4,
     kETypeFieldNumber = 3,
+    kCompressTypeFieldNumber = 6,
   };
   // bytes data = 5;
   void clear_data();
@@ -828,6 +863,15 @@ class Entry :
   void _internal_set_e_type(::eraftkv::EntryType value);
   public:
 
+  // .eraftkv.CompressType compress_type = 6;
+  void clear_compress_type();
+  ::eraftkv::CompressType compress_type() const;
+  void set_compress_type(::eraftkv::CompressType value);
+  private:
+  ::eraftkv::CompressType _internal_compress_type() const;
+  void _internal_set_compress_type(::eraftkv::CompressType value);
+  public:
+
   // @@protoc_insertion_point(class_scope:eraftkv.Entry)
  private:
   class _Internal;
@@ -838,6 +882,7 @@ class Entry :
   ::PROTOBUF_NAMESPACE_ID::int64 id_;
   ::PROTOBUF_NAMESPACE_ID::int64 data_size_;
   int e_type_;
+  int compress_type_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_eraftkv_2eproto;
 };
@@ -3359,6 +3404,306 @@ class SSTFileContent :
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_eraftkv_2eproto;
 };
+// -------------------------------------------------------------------
+
+class ReadIndexReq :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:eraftkv.ReadIndexReq) */ {
+ public:
+  ReadIndexReq();
+  virtual ~ReadIndexReq();
+
+  ReadIndexReq(const ReadIndexReq& from);
+  ReadIndexReq(ReadIndexReq&& from) noexcept
+    : ReadIndexReq() {
+    *this = ::std::move(from);
+  }
+
+  inline ReadIndexReq& operator=(const ReadIndexReq& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ReadIndexReq& operator=(ReadIndexReq&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const ReadIndexReq& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const ReadIndexReq* internal_default_instance() {
+    return reinterpret_cast<const ReadIndexReq*>(
+               &_ReadIndexReq_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    17;
+
+  friend void swap(ReadIndexReq& a, ReadIndexReq& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ReadIndexReq* other) {
+    if (other == this) return;
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline ReadIndexReq* New() const final {
+    return CreateMaybeMessage<ReadIndexReq>(nullptr);
+  }
+
+  ReadIndexReq* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<ReadIndexReq>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const ReadIndexReq& from);
+  void MergeFrom(const ReadIndexReq& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ReadIndexReq* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "eraftkv.ReadIndexReq";
+  }
+  private:
+  inline ::PROTOBUF_NAMESPACE_ID::Arena* GetArenaNoVirtual() const {
+    return nullptr;
+  }
+  inline void* MaybeArenaPtr() const {
+    return nullptr;
+  }
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_eraftkv_2eproto);
+    return ::descriptor_table_eraftkv_2eproto.file_level_metadata[kIndexInFileMessages];
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kFromIdFieldNumber = 1,
+    kTermFieldNumber = 2,
+  };
+  // int64 from_id = 1;
+  void clear_from_id();
+  ::PROTOBUF_NAMESPACE_ID::int64 from_id() const;
+  void set_from_id(::PROTOBUF_NAMESPACE_ID::int64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::int64 _internal_from_id() const;
+  void _internal_set_from_id(::PROTOBUF_NAMESPACE_ID::int64 value);
+  public:
+
+  // int64 term = 2;
+  void clear_term();
+  ::PROTOBUF_NAMESPACE_ID::int64 term() const;
+  void set_term(::PROTOBUF_NAMESPACE_ID::int64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::int64 _internal_term() const;
+  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::int64 value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:eraftkv.ReadIndexReq)
+ private:
+  class _Internal;
+
+  ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::int64 from_id_;
+  ::PROTOBUF_NAMESPACE_ID::int64 term_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_eraftkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ReadIndexResp :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:eraftkv.ReadIndexResp) */ {
+ public:
+  ReadIndexResp();
+  virtual ~ReadIndexResp();
+
+  ReadIndexResp(const ReadIndexResp& from);
+  ReadIndexResp(ReadIndexResp&& from) noexcept
+    : ReadIndexResp() {
+    *this = ::std::move(from);
+  }
+
+  inline ReadIndexResp& operator=(const ReadIndexResp& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ReadIndexResp& operator=(ReadIndexResp&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const ReadIndexResp& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const ReadIndexResp* internal_default_instance() {
+    return reinterpret_cast<const ReadIndexResp*>(
+               &_ReadIndexResp_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    18;
+
+  friend void swap(ReadIndexResp& a, ReadIndexResp& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ReadIndexResp* other) {
+    if (other == this) return;
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline ReadIndexResp* New() const final {
+    return CreateMaybeMessage<ReadIndexResp>(nullptr);
+  }
+
+  ReadIndexResp* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<ReadIndexResp>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const ReadIndexResp& from);
+  void MergeFrom(const ReadIndexResp& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ReadIndexResp* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "eraftkv.ReadIndexResp";
+  }
+  private:
+  inline ::PROTOBUF_NAMESPACE_ID::Arena* GetArenaNoVirtual() const {
+    return nullptr;
+  }
+  inline void* MaybeArenaPtr() const {
+    return nullptr;
+  }
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_eraftkv_2eproto);
+    return ::descriptor_table_eraftkv_2eproto.file_level_metadata[kIndexInFileMessages];
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kReadIndexFieldNumber = 2,
+    kTermFieldNumber = 3,
+    kLeaderIdFieldNumber = 4,
+    kSuccessFieldNumber = 1,
+  };
+  // int64 read_index = 2;
+  void clear_read_index();
+  ::PROTOBUF_NAMESPACE_ID::int64 read_index() const;
+  void set_read_index(::PROTOBUF_NAMESPACE_ID::int64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::int64 _internal_read_index() const;
+  void _internal_set_read_index(::PROTOBUF_NAMESPACE_ID::int64 value);
+  public:
+
+  // int64 term = 3;
+  void clear_term();
+  ::PROTOBUF_NAMESPACE_ID::int64 term() const;
+  void set_term(::PROTOBUF_NAMESPACE_ID::int64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::int64 _internal_term() const;
+  void _internal_set_term(::PROTOBUF_NAMESPACE_ID::int64 value);
+  public:
+
+  // int64 leader_id = 4;
+  void clear_leader_id();
+  ::PROTOBUF_NAMESPACE_ID::int64 leader_id() const;
+  void set_leader_id(::PROTOBUF_NAMESPACE_ID::int64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::int64 _internal_leader_id() const;
+  void _internal_set_leader_id(::PROTOBUF_NAMESPACE_ID::int64 value);
+  public:
+
+  // bool success = 1;
+  void clear_success();
+  bool success() const;
+  void set_success(bool value);
+  private:
+  bool _internal_success() const;
+  void _internal_set_success(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:eraftkv.ReadIndexResp)
+ private:
+  class _Internal;
+
+  ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::int64 read_index_;
+  ::PROTOBUF_NAMESPACE_ID::int64 term_;
+  ::PROTOBUF_NAMESPACE_ID::int64 leader_id_;
+  bool success_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_eraftkv_2eproto;
+};
 // ===================================================================
 
 
@@ -3718,6 +4063,26 @@ inline void Entry::set_allocated_data(std::string* data) {
   // @@protoc_insertion_point(field_set_allocated:eraftkv.Entry.data)
 }
 
+// .eraftkv.CompressType compress_type = 6;
+inline void Entry::clear_compress_type() {
+  compress_type_ = 0;
+}
+inline ::eraftkv::CompressType Entry::_internal_compress_type() const {
+  return static_cast< ::eraftkv::CompressType >(compress_type_);
+}
+inline ::eraftkv::CompressType Entry::compress_type() const {
+  // @@protoc_insertion_point(field_get:eraftkv.Entry.compress_type)
+  return _internal_compress_type();
+}
+inline void Entry::_internal_set_compress_type(::eraftkv::CompressType value) {
+  
+  compress_type_ = value;
+}
+inline void Entry::set_compress_type(::eraftkv::CompressType value) {
+  _internal_set_compress_type(value);
+  // @@protoc_insertion_point(field_set:eraftkv.Entry.compress_type)
+}
+
 // -------------------------------------------------------------------
 
 // AppendEntriesReq
@@ -5748,6 +6113,134 @@ inline void SSTFileContent::set_allocated_content(std::string* content) {
   // @@protoc_insertion_point(field_set_allocated:eraftkv.SSTFileContent.content)
 }
 
+// -------------------------------------------------------------------
+
+// ReadIndexReq
+
+// int64 from_id = 1;
+inline void ReadIndexReq::clear_from_id() {
+  from_id_ = PROTOBUF_LONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexReq::_internal_from_id() const {
+  return from_id_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexReq::from_id() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexReq.from_id)
+  return _internal_from_id();
+}
+inline void ReadIndexReq::_internal_set_from_id(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  
+  from_id_ = value;
+}
+inline void ReadIndexReq::set_from_id(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  _internal_set_from_id(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexReq.from_id)
+}
+
+// int64 term = 2;
+inline void ReadIndexReq::clear_term() {
+  term_ = PROTOBUF_LONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexReq::_internal_term() const {
+  return term_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexReq::term() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexReq.term)
+  return _internal_term();
+}
+inline void ReadIndexReq::_internal_set_term(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  
+  term_ = value;
+}
+inline void ReadIndexReq::set_term(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  _internal_set_term(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexReq.term)
+}
+
+// -------------------------------------------------------------------
+
+// ReadIndexResp
+
+// bool success = 1;
+inline void ReadIndexResp::clear_success() {
+  success_ = false;
+}
+inline bool ReadIndexResp::_internal_success() const {
+  return success_;
+}
+inline bool ReadIndexResp::success() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexResp.success)
+  return _internal_success();
+}
+inline void ReadIndexResp::_internal_set_success(bool value) {
+  
+  success_ = value;
+}
+inline void ReadIndexResp::set_success(bool value) {
+  _internal_set_success(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexResp.success)
+}
+
+// int64 read_index = 2;
+inline void ReadIndexResp::clear_read_index() {
+  read_index_ = PROTOBUF_LONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::_internal_read_index() const {
+  return read_index_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::read_index() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexResp.read_index)
+  return _internal_read_index();
+}
+inline void ReadIndexResp::_internal_set_read_index(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  
+  read_index_ = value;
+}
+inline void ReadIndexResp::set_read_index(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  _internal_set_read_index(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexResp.read_index)
+}
+
+// int64 term = 3;
+inline void ReadIndexResp::clear_term() {
+  term_ = PROTOBUF_LONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::_internal_term() const {
+  return term_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::term() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexResp.term)
+  return _internal_term();
+}
+inline void ReadIndexResp::_internal_set_term(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  
+  term_ = value;
+}
+inline void ReadIndexResp::set_term(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  _internal_set_term(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexResp.term)
+}
+
+// int64 leader_id = 4;
+inline void ReadIndexResp::clear_leader_id() {
+  leader_id_ = PROTOBUF_LONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::_internal_leader_id() const {
+  return leader_id_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 ReadIndexResp::leader_id() const {
+  // @@protoc_insertion_point(field_get:eraftkv.ReadIndexResp.leader_id)
+  return _internal_leader_id();
+}
+inline void ReadIndexResp::_internal_set_leader_id(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  
+  leader_id_ = value;
+}
+inline void ReadIndexResp::set_leader_id(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  _internal_set_leader_id(value);
+  // @@protoc_insertion_point(field_set:eraftkv.ReadIndexResp.leader_id)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -5783,6 +6276,10 @@ inline void SSTFileContent::set_allocated_content(std::string* content) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -5800,6 +6297,11 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::eraftkv::EntryType>() {
   return ::eraftkv::EntryType_descriptor();
 }
+template <> struct is_proto_enum< ::eraftkv::CompressType> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::eraftkv::CompressType>() {
+  return ::eraftkv::CompressType_descriptor();
+}
 template <> struct is_proto_enum< ::eraftkv::SlotStatus> : ::std::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::eraftkv::SlotStatus>() {
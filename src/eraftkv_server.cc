@@ -37,6 +37,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <set>
 
 #include "consts.h"
 #include "file_reader_into_stream.h"
@@ -45,12 +46,47 @@
 
 RaftServer* ERaftKvServer::raft_context_ = nullptr;
 
+RaftGroupHost* ERaftKvServer::raft_host_ = nullptr;
+
 std::map<int, std::condition_variable*> ERaftKvServer::ready_cond_vars_;
 
 std::mutex ERaftKvServer::ready_mutex_;
 
 bool ERaftKvServer::is_ok_ = false;
 
+/**
+ * @brief raft rpcs carry their group id in the rpc metadata, rpcs without
+ * it come from single group peers and go to the default group
+ *
+ * @param context
+ * @return RaftServer*
+ */
+RaftServer* ERaftKvServer::RouteRaftGroup(ServerContext* context) {
+  if (raft_host_ == nullptr) {
+    return raft_context_;
+  }
+  int64_t group_id = DEFAULT_RAFT_GROUP_ID;
+  auto    metadata = context->client_metadata();
+  auto    it = metadata.find(RAFT_GROUP_ID_METADATA_KEY);
+  if (it != metadata.end()) {
+    group_id = std::stoll(std::string(it->second.data(), it->second.size()));
+  }
+  return raft_host_->GetGroup(group_id);
+}
+
+std::vector<RaftServer*> ERaftKvServer::RouteKeys(
+    const eraftkv::ClientOperationReq* req) {
+  if (raft_host_ == nullptr) {
+    return std::vector<RaftServer*>(req->kvs_size(), raft_context_);
+  }
+  std::vector<std::string> keys;
+  keys.reserve(req->kvs_size());
+  for (const auto& kv_op : req->kvs()) {
+    keys.push_back(kv_op.key());
+  }
+  return raft_host_->GetGroupsByKeys(keys);
+}
+
 /**
  * @brief
  *
@@ -61,7 +97,11 @@ bool ERaftKvServer::is_ok_ = false;
 grpc::Status ERaftKvServer::RequestVote(ServerContext*                 context,
                                         const eraftkv::RequestVoteReq* req,
                                         eraftkv::RequestVoteResp*      resp) {
-  if (raft_context_->HandleRequestVoteReq(nullptr, req, resp) == EStatus::kOk) {
+  RaftServer* raft = RouteRaftGroup(context);
+  if (raft == nullptr) {
+    return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown raft group");
+  }
+  if (raft->HandleRequestVoteReq(nullptr, req, resp) == EStatus::kOk) {
     return grpc::Status::OK;
   } else {
     return grpc::Status::CANCELLED;
@@ -78,8 +118,11 @@ grpc::Status ERaftKvServer::RequestVote(ServerContext*                 context,
 grpc::Status ERaftKvServer::AppendEntries(ServerContext* context,
                                           const eraftkv::AppendEntriesReq* req,
                                           eraftkv::AppendEntriesResp* resp) {
-  if (raft_context_->HandleAppendEntriesReq(nullptr, req, resp) ==
-      EStatus::kOk) {
+  RaftServer* raft = RouteRaftGroup(context);
+  if (raft == nullptr) {
+    return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown raft group");
+  }
+  if (raft->HandleAppendEntriesReq(nullptr, req, resp) == EStatus::kOk) {
     return grpc::Status::OK;
   } else {
     return grpc::Status::CANCELLED;
@@ -96,13 +139,36 @@ grpc::Status ERaftKvServer::AppendEntries(ServerContext* context,
 grpc::Status ERaftKvServer::Snapshot(ServerContext*              context,
                                      const eraftkv::SnapshotReq* req,
                                      eraftkv::SnapshotResp*      resp) {
-  if (raft_context_->HandleSnapshotReq(nullptr, req, resp) == EStatus::kOk) {
+  RaftServer* raft = RouteRaftGroup(context);
+  if (raft == nullptr) {
+    return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown raft group");
+  }
+  if (raft->HandleSnapshotReq(nullptr, req, resp) == EStatus::kOk) {
     return grpc::Status::OK;
   } else {
     return grpc::Status::CANCELLED;
   }
 }
 
+/**
+ * @brief
+ *
+ * @param req
+ * @param resp
+ * @return grpc::Status
+ */
+grpc::Status ERaftKvServer::ReadIndex(ServerContext*               context,
+                                      const eraftkv::ReadIndexReq* req,
+                                      eraftkv::ReadIndexResp*      resp) {
+  RaftServer* raft = RouteRaftGroup(context);
+  if (raft == nullptr) {
+    return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown raft group");
+  }
+  // a rejected read index is reported through resp->success()
+  raft->HandleReadIndexReq(req, resp);
+  return grpc::Status::OK;
+}
+
 /**
  * @brief
  *
@@ -119,29 +185,62 @@ grpc::Status ERaftKvServer::ProcessRWOperation(
   bool    success;
   SPDLOG_INFO(
       "recv rw op with ts {} {}", req->op_timestamp(), req->DebugString());
-  // no leader reject
-  if (!raft_context_->IsLeader()) {
-    resp->set_error_code(eraftkv::ErrorCode::REQUEST_NOT_LEADER_NODE);
-    resp->set_leader_addr(raft_context_->GetLeaderId());
-    return grpc::Status::OK;
-  }
-  // snapshot reject
-  if (raft_context_->IsSnapshoting()) {
-    SPDLOG_WARN("node is snapshoting, reject request");
-    resp->set_error_code(eraftkv::ErrorCode::NODE_IS_SNAPSHOTING);
-    return grpc::Status::OK;
+  // each key is served by the raft group owning its slot, followers serve
+  // gets through a read index forwarded to the leader, writes still have to
+  // go to the leader
+  std::vector<RaftServer*> rafts = RouteKeys(req);
+  for (int i = 0; i < req->kvs_size(); i++) {
+    const auto& kv_op = req->kvs(i);
+    RaftServer* raft = rafts[i];
+    if ((kv_op.op_type() == eraftkv::ClientOpType::Put ||
+         kv_op.op_type() == eraftkv::ClientOpType::Del) &&
+        !raft->IsLeader()) {
+      resp->set_error_code(eraftkv::ErrorCode::REQUEST_NOT_LEADER_NODE);
+      resp->set_leader_addr(raft->GetLeaderId());
+      return grpc::Status::OK;
+    }
+    // snapshot reject
+    if (raft->IsSnapshoting()) {
+      SPDLOG_WARN("node is snapshoting, reject request");
+      resp->set_error_code(eraftkv::ErrorCode::NODE_IS_SNAPSHOTING);
+      return grpc::Status::OK;
+    }
   }
-  for (auto kv_op : req->kvs()) {
-    int rand_seq = static_cast<int>(RandomNumber::Between(1, 100000));
+  std::set<RaftServer*> read_index_confirmed;
+  for (int i = 0; i < req->kvs_size(); i++) {
+    const eraftkv::KvOpPair& kv_op = req->kvs(i);
+    RaftServer*              raft = rafts[i];
+    int         rand_seq = static_cast<int>(RandomNumber::Between(1, 100000));
     SPDLOG_INFO("recv rw op type {} op count {}", kv_op.op_type(), rand_seq);
     switch (kv_op.op_type()) {
       case eraftkv::ClientOpType::Get: {
-        auto val = raft_context_->store_->GetKV(kv_op.key());
-        SPDLOG_INFO(" get key {}  with value {}", kv_op.key(), val.first);
+        // the gets of a group in the request are served behind one read
+        // index
+        if (read_index_confirmed.count(raft) == 0) {
+          int64_t read_index;
+          auto    st = raft->ReadIndex(&read_index);
+          if (st != EStatus::kOk) {
+            SPDLOG_WARN("read index failed, reject get request");
+            resp->set_error_code(
+                st == EStatus::kNotSupport
+                    ? eraftkv::ErrorCode::REQUEST_NOT_LEADER_NODE
+                    : eraftkv::ErrorCode::REQUEST_TIMEOUT);
+            resp->set_leader_addr(raft->GetLeaderId());
+            return grpc::Status::OK;
+          }
+          read_index_confirmed.insert(raft);
+        }
         auto res = resp->add_ops();
         res->set_key(kv_op.key());
-        res->set_value(val.first);
-        res->set_success(val.second);
+        // a value read from the memtable is copied straight into the
+        // response, a value pinned in the block cache is copied from there
+        rocksdb::PinnableSlice val(res->mutable_value());
+        auto get_st = raft->store_->GetKV(kv_op.key(), &val);
+        if (get_st == EStatus::kOk && val.IsPinned()) {
+          res->set_value(val.data(), val.size());
+        }
+        SPDLOG_INFO(" get key {} with {} value bytes", kv_op.key(), val.size());
+        res->set_success(get_st != EStatus::kNotFound);
         res->set_op_type(eraftkv::ClientOpType::Get);
         res->set_op_sign(kv_op.op_sign());
         break;
@@ -153,10 +252,11 @@ grpc::Status ERaftKvServer::ProcessRWOperation(
           std::condition_variable*    new_var = new std::condition_variable();
           std::lock_guard<std::mutex> lg(map_mutex_);
           ERaftKvServer::ready_cond_vars_[rand_seq] = new_var;
-          kv_op.set_op_sign(rand_seq);
         }
-        raft_context_->Propose(
-            kv_op.SerializeAsString(), &log_index, &log_term, &success);
+        eraftkv::KvOpPair prop_op = kv_op;
+        prop_op.set_op_sign(rand_seq);
+        raft->Propose(
+            prop_op.SerializeAsString(), &log_index, &log_term, &success);
         {
           auto endTime =
               std::chrono::system_clock::now() + std::chrono::seconds(5);
@@ -227,6 +327,12 @@ grpc::Status ERaftKvServer::ClusterConfigChange(
       return grpc::Status::OK;
     }
     default: {
+      // a membership change would only reach the default group, the other
+      // groups would keep replicating to the old members
+      if (raft_host_ != nullptr) {
+        return grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
+                            "membership change needs a single raft group");
+      }
       // no leader reject
       if (!raft_context_->IsLeader()) {
         resp->set_error_code(eraftkv::ErrorCode::REQUEST_NOT_LEADER_NODE);
@@ -269,16 +375,21 @@ grpc::Status ERaftKvServer::PutSSTFile(
     ServerContext*                               context,
     grpc::ServerReader<eraftkv::SSTFileContent>* reader,
     eraftkv::SSTFileId*                          fileId) {
+  // the files are ingested by the group the sender named in the metadata
+  RaftServer* raft = RouteRaftGroup(context);
+  if (raft == nullptr) {
+    return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown raft group");
+  }
   eraftkv::SSTFileContent sst_file;
   SequentialFileWriter    writer;
-  DirectoryTool::MkDir("/eraft/data/sst_recv/");
+  std::string             recv_dir = raft->SnapshotRecvDir();
+  DirectoryTool::MkDir(recv_dir);
   uint64_t sec = std::chrono::duration_cast<std::chrono::milliseconds>(
                      std::chrono::system_clock::now().time_since_epoch())
                      .count();
   SPDLOG_INFO(
       "recv sst filename {} id {} sec {}", sst_file.name(), sst_file.id(), sec);
-  writer.OpenIfNecessary("/eraft/data/sst_recv/" + std::to_string(sec) +
-                         ".sst");
+  writer.OpenIfNecessary(recv_dir + std::to_string(sec) + ".sst");
   while (reader->Read(&sst_file)) {
     try {
       auto* const data = sst_file.mutable_content();
@@ -38,17 +38,21 @@
 #include <prometheus/exposer.h>
 #include <prometheus/registry.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <string>
 
+#include "compress_util.h"
 #include "eraftkv.grpc.pb.h"
 #include "eraftkv.pb.h"
 #include "estatus.h"
 #include "grpc_network_impl.h"
+#include "raft_group_host.h"
 #include "raft_server.h"
 #include "rocksdb_storage_impl.h"
+#include "segment_log_storage_impl.h"
 #include "util.h"
 
 using eraftkv::ERaftKv;
@@ -79,14 +83,48 @@ struct ERaftKvServerOptions {
 
   int64_t response_timeout;
 
-  int64_t ae_max_count;
-  int64_t ae_max_size;
+  int64_t ae_max_count = MAX_ENTRIES_PER_APPEND_REQ;
+  int64_t ae_max_size = MAX_BYTES_PER_APPEND_REQ;
 
   int64_t snap_max_count;
   int64_t snap_max_size;
 
   int64_t grpc_max_recv_msg_size;
   int64_t grpc_max_send_msg_size;
+
+  ReadModeEnum read_mode = ReadModeEnum::ReadOnlySafe;
+  int64_t      clock_drift_bound_ms = 0;
+
+  int64_t raft_groups = 1;
+
+  bool log_gc_async = false;
+
+  /**
+   * @brief raft log engine of a single group server, "rocksdb" or
+   * "segment" for the append only segment files
+   *
+   */
+  std::string log_engine = "rocksdb";
+
+  /**
+   * @brief codec of the proposed log entry payloads, "none", "lz4" or "zstd"
+   *
+   */
+  std::string log_compress = "none";
+
+  /**
+   * @brief tuning profile of the rocksdb log entry column family, in rocksdb
+   * options string format, e.g. "write_buffer_size=134217728"
+   *
+   */
+  std::string log_db_options;
+
+  /**
+   * @brief threads applying the committed entries of a raft group, a long
+   * run of normal entries is split over them by key hash
+   *
+   */
+  int64_t apply_workers = 1;
 };
 
 class ERaftKvServer : public eraftkv::ERaftKv::Service {
@@ -108,12 +146,48 @@ class ERaftKvServer : public eraftkv::ERaftKv::Service {
       count++;
     }
     raft_config.snap_path = options_.snap_db_path;
+    raft_config.read_mode = options_.read_mode;
+    raft_config.clock_drift_bound_ms = options_.clock_drift_bound_ms;
+    raft_config.max_entries_per_append = options_.ae_max_count;
+    raft_config.max_bytes_per_append = options_.ae_max_size;
+    raft_config.log_compress = CompressUtil::ParseType(options_.log_compress);
+    raft_config.apply_workers = options_.apply_workers;
     options_.svr_addr = raft_config.peer_address_map[options_.svr_id];
+    if (options_.raft_groups > 1) {
+      // split the key slots over the groups, group 0 also serves the
+      // cluster config and snapshot requests
+      int64_t groups = std::min<int64_t>(options_.raft_groups, KEY_SLOT_COUNT);
+      raft_host_ = new RaftGroupHost(raft_config,
+                                     options_.log_db_path,
+                                     RAFT_GROUP_APPLY_THREADS,
+                                     options_.log_db_options,
+                                     options_.log_gc_async);
+      for (int64_t g = 0; g < groups; g++) {
+        raft_host_->AddGroup(g,
+                             g * KEY_SLOT_COUNT / groups,
+                             (g + 1) * KEY_SLOT_COUNT / groups - 1,
+                             options_.kv_db_path + "_g" + std::to_string(g));
+      }
+      raft_host_->Start();
+      raft_context_ = raft_host_->GetGroup(DEFAULT_RAFT_GROUP_ID);
+      return;
+    }
     GRpcNetworkImpl* net_rpc = new GRpcNetworkImpl();
     net_rpc->InitPeerNodeConnections(raft_config.peer_address_map);
-    RocksDBSingleLogStorageImpl* log_db =
-        new RocksDBSingleLogStorageImpl(options_.log_db_path);
-    RocksDBStorageImpl* kv_db = new RocksDBStorageImpl(options_.kv_db_path);
+    LogStore* log_db = nullptr;
+    if (options_.log_engine == "segment") {
+      log_db = new SegmentLogStorageImpl(options_.log_db_path);
+    } else {
+      RocksDBSingleLogStorageImpl* rocksdb_log_db =
+          new RocksDBSingleLogStorageImpl(options_.log_db_path,
+                                          options_.log_db_options);
+      if (options_.log_gc_async) {
+        rocksdb_log_db->StartBackgroundGc();
+      }
+      log_db = rocksdb_log_db;
+    }
+    RocksDBStorageImpl* kv_db =
+        new RocksDBStorageImpl(options_.kv_db_path, options_.apply_workers);
     raft_context_ =
         RaftServer::RunMainLoop(raft_config, log_db, kv_db, net_rpc);
 
@@ -174,6 +248,18 @@ class ERaftKvServer : public eraftkv::ERaftKv::Service {
                              const eraftkv::ClusterConfigChangeReq* req,
                              eraftkv::ClusterConfigChangeResp*      resp);
 
+  /**
+   * @brief return the leader's confirmed commit index to a follower serving
+   * a read
+   *
+   * @param req
+   * @param resp
+   * @return grpc::Status
+   */
+  Status ReadIndex(ServerContext*               context,
+                   const eraftkv::ReadIndexReq* req,
+                   eraftkv::ReadIndexResp*      resp);
+
 
   Status PutSSTFile(ServerContext*                               context,
                     grpc::ServerReader<eraftkv::SSTFileContent>* reader,
@@ -217,6 +303,31 @@ class ERaftKvServer : public eraftkv::ERaftKv::Service {
    */
   static RaftServer* raft_context_;
 
+  /**
+   * @brief the raft groups of this server, nullptr when it runs a single
+   * group
+   *
+   */
+  static RaftGroupHost* raft_host_;
+
+  /**
+   * @brief the raft group a raft rpc is addressed to
+   *
+   * @param context
+   * @return RaftServer* nullptr if the group is not hosted here
+   */
+  static RaftServer* RouteRaftGroup(ServerContext* context);
+
+  /**
+   * @brief the raft groups serving the keys of req, the i-th group serves
+   * the i-th kv
+   *
+   * @param req
+   * @return std::vector<RaftServer*>
+   */
+  static std::vector<RaftServer*> RouteKeys(
+      const eraftkv::ClientOperationReq* req);
+
 
   int op_sign;
 };
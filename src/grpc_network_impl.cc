@@ -38,9 +38,11 @@
 #include <spdlog/spdlog.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 
+#include "consts.h"
 #include "eraftkv.grpc.pb.h"
 #include "eraftkv.pb.h"
 #include "file_reader_into_stream.h"
@@ -53,6 +55,37 @@ using eraftkv::ERaftKv;
 using grpc::Channel;
 using grpc::ClientContext;
 using grpc::Status;
+
+/**
+ * @brief tag a raft rpc with the group id of the sender, the receiving
+ * process routes it to its raft server of the same group
+ *
+ * @param raft
+ * @param context
+ */
+static void SetRaftGroupMetadata(RaftServer* raft, ClientContext* context) {
+  context->AddMetadata(RAFT_GROUP_ID_METADATA_KEY,
+                       std::to_string(raft->GetGroupId()));
+}
+
+/**
+ * @brief Construct a new GRpcNetworkImpl object
+ *
+ */
+GRpcNetworkImpl::GRpcNetworkImpl()
+    : cq_thread_(&GRpcNetworkImpl::AsyncCompleteRpc, this) {}
+
+/**
+ * @brief Destroy the GRpcNetworkImpl object
+ *
+ */
+GRpcNetworkImpl::~GRpcNetworkImpl() {
+  this->cq_.Shutdown();
+  if (this->cq_thread_.joinable()) {
+    this->cq_thread_.join();
+  }
+}
+
 /**
  * @brief
  *
@@ -69,22 +102,23 @@ EStatus GRpcNetworkImpl::SendRequestVote(RaftServer*              raft,
   if (stub_ == nullptr) {
     return EStatus::kNotFound;
   }
-  eraftkv::RequestVoteResp* resp = new eraftkv::RequestVoteResp;
-  resp->set_request_term(0);
-  resp->set_term(0);
-  resp->set_leader_id(-1);
-  ClientContext context;
-  auto          status = stub_->RequestVote(&context, *req, resp);
-  if (raft->HandleRequestVoteResp(target_node, req, resp) == EStatus::kOk) {
-    return EStatus::kOk;
-  } else {
-    return EStatus::kNotFound;
-  }
-  delete resp;
+  // the votes are sent from the timer thread, which must not wait on a
+  // peer that is down
+  AsyncRequestVoteCall* call = new AsyncRequestVoteCall;
+  call->raft = raft;
+  call->target_node = target_node;
+  call->req.CopyFrom(*req);
+  SetRaftGroupMetadata(raft, &call->context);
+  call->context.set_deadline(
+      std::chrono::system_clock::now() +
+      std::chrono::milliseconds(REQUEST_VOTE_RPC_TIMEOUT_MS));
+  call->response_reader =
+      stub_->PrepareAsyncRequestVote(&call->context, call->req, &this->cq_);
+  call->response_reader->StartCall();
+  call->response_reader->Finish(&call->resp, &call->status, (void*)call);
   return EStatus::kOk;
 }
 
-
 /**
  * @brief
  *
@@ -96,33 +130,68 @@ EStatus GRpcNetworkImpl::SendRequestVote(RaftServer*              raft,
 EStatus GRpcNetworkImpl::SendAppendEntries(RaftServer* raft,
                                            RaftNode*   target_node,
                                            eraftkv::AppendEntriesReq* req) {
-  SPDLOG_INFO("send append entries request to {} req {}",
-              target_node->address,
-              req->DebugString());
+  SPDLOG_DEBUG("send append entries request to {} prev_log_index {} "
+               "entries {}",
+               target_node->address,
+               req->prev_log_index(),
+               req->entries_size());
   ERaftKv::Stub* stub_ = GetPeerNodeConnection(target_node->id);
   if (stub_ == nullptr) {
     return EStatus::kNotFound;
   }
-  eraftkv::AppendEntriesResp* resp = new eraftkv::AppendEntriesResp;
-  resp->set_term(0);
-  resp->set_current_index(0);
-  resp->set_conflict_index(0);
-  resp->set_conflict_term(0);
-  ClientContext context;
-  auto          status = stub_->AppendEntries(&context, *req, resp);
-  if (!status.ok()) {
-    SPDLOG_INFO(" send append req to {} failed! ", target_node->address);
-    target_node->node_state = NodeStateEnum::LostConnection;
-  } else {
-    target_node->node_state = NodeStateEnum::Running;
+  AsyncAppendEntriesCall* call = new AsyncAppendEntriesCall;
+  call->raft = raft;
+  call->target_node = target_node;
+  call->req.Swap(req);
+  SetRaftGroupMetadata(raft, &call->context);
+  call->context.set_deadline(
+      std::chrono::system_clock::now() +
+      std::chrono::milliseconds(APPEND_ENTRIES_RPC_TIMEOUT_MS));
+  call->response_reader =
+      stub_->PrepareAsyncAppendEntries(&call->context, call->req, &this->cq_);
+  call->response_reader->StartCall();
+  call->response_reader->Finish(&call->resp, &call->status, (void*)call);
+  return EStatus::kOk;
+}
+
+/**
+ * @brief
+ *
+ */
+void GRpcNetworkImpl::AsyncCompleteRpc() {
+  void* got_tag;
+  bool  ok = false;
+  while (this->cq_.Next(&got_tag, &ok)) {
+    AsyncRaftCall* call = static_cast<AsyncRaftCall*>(got_tag);
+    call->Complete(ok);
+    delete call;
   }
-  if (raft->HandleAppendEntriesResp(target_node, req, resp) == EStatus::kOk) {
-    return EStatus::kOk;
+}
+
+void AsyncAppendEntriesCall::Complete(bool ok) {
+  if (ok && this->status.ok()) {
+    this->target_node->node_state = NodeStateEnum::Running;
+    this->raft->HandleAppendEntriesResp(
+        this->target_node, &this->req, &this->resp);
   } else {
-    return EStatus::kNotFound;
+    SPDLOG_INFO(" send append req to {} failed! {}",
+                this->target_node->address,
+                this->status.error_message());
+    this->target_node->node_state = NodeStateEnum::LostConnection;
+    this->raft->HandleAppendEntriesResp(this->target_node, &this->req, nullptr);
   }
-  delete resp;
-  return EStatus::kOk;
+}
+
+void AsyncRequestVoteCall::Complete(bool ok) {
+  // a vote that did not arrive grants nothing
+  if (!ok || !this->status.ok()) {
+    SPDLOG_INFO(" send vote req to {} failed! {}",
+                this->target_node->address,
+                this->status.error_message());
+    return;
+  }
+  this->raft->HandleRequestVoteResp(
+      this->target_node, &this->req, &this->resp);
 }
 
 /**
@@ -147,13 +216,14 @@ EStatus GRpcNetworkImpl::SendSnapshot(RaftServer*           raft,
   resp->set_term(0);
   resp->set_offset(0);
   ClientContext context;
-  auto          status = stub_->Snapshot(&context, *req, resp);
-  if (raft->HandleSnapshotResp(target_node, req, resp) == EStatus::kOk) {
-    return EStatus::kOk;
-  } else {
+  SetRaftGroupMetadata(raft, &context);
+  auto    status = stub_->Snapshot(&context, *req, resp);
+  EStatus st =
+      raft->HandleSnapshotResp(target_node, req, status.ok() ? resp : nullptr);
+  delete resp;
+  if (!status.ok() || st != EStatus::kOk) {
     return EStatus::kNotFound;
   }
-  delete resp;
   return EStatus::kOk;
 }
 
@@ -167,6 +237,7 @@ EStatus GRpcNetworkImpl::SendFile(RaftServer*        raft,
   }
   ClientContext       context;
   eraftkv::SSTFileId* fid = new eraftkv::SSTFileId;
+  SetRaftGroupMetadata(raft, &context);
 
   std::unique_ptr<grpc::ClientWriter<eraftkv::SSTFileContent>> writer(
       stub_->PutSSTFile(&context, fid));
@@ -194,6 +265,38 @@ EStatus GRpcNetworkImpl::SendFile(RaftServer*        raft,
 }
 
 
+/**
+ * @brief
+ *
+ * @param raft
+ * @param target_node
+ * @param req
+ * @param resp
+ * @return EStatus
+ */
+EStatus GRpcNetworkImpl::SendReadIndex(RaftServer*             raft,
+                                       RaftNode*               target_node,
+                                       eraftkv::ReadIndexReq*  req,
+                                       eraftkv::ReadIndexResp* resp) {
+  SPDLOG_DEBUG("send read index request to {}", target_node->address);
+  ERaftKv::Stub* stub_ = GetPeerNodeConnection(target_node->id);
+  if (stub_ == nullptr) {
+    return EStatus::kNotFound;
+  }
+  ClientContext context;
+  SetRaftGroupMetadata(raft, &context);
+  context.set_deadline(std::chrono::system_clock::now() +
+                       std::chrono::milliseconds(READ_INDEX_TIMEOUT_MS));
+  auto status = stub_->ReadIndex(&context, *req, resp);
+  if (!status.ok()) {
+    SPDLOG_INFO("send read index req to {} failed! {}",
+                target_node->address,
+                status.error_message());
+    return EStatus::kError;
+  }
+  return EStatus::kOk;
+}
+
 /**
  * @brief
  *
@@ -34,17 +34,82 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <thread>
+
 #include "eraftkv.grpc.pb.h"
 #include "eraftkv.pb.h"
 #include "raft_server.h"
 
 using eraftkv::ERaftKv;
 
+/**
+ * @brief state of one in flight async raft rpc, the tag of its completion
+ * queue event
+ *
+ */
+struct AsyncRaftCall {
+  RaftServer*         raft;
+  RaftNode*           target_node;
+  grpc::ClientContext context;
+  grpc::Status        status;
+
+  virtual ~AsyncRaftCall() {}
+
+  /**
+   * @brief hand the response to the raft server on the completion queue
+   * thread
+   *
+   * @param ok false if the rpc did not finish
+   */
+  virtual void Complete(bool ok) = 0;
+};
+
+/**
+ * @brief state of one in flight async append entries rpc
+ *
+ */
+struct AsyncAppendEntriesCall : public AsyncRaftCall {
+  eraftkv::AppendEntriesReq  req;
+  eraftkv::AppendEntriesResp resp;
+  std::unique_ptr<grpc::ClientAsyncResponseReader<eraftkv::AppendEntriesResp>>
+      response_reader;
+
+  void Complete(bool ok) override;
+};
+
+/**
+ * @brief state of one in flight async request vote rpc
+ *
+ */
+struct AsyncRequestVoteCall : public AsyncRaftCall {
+  eraftkv::RequestVoteReq  req;
+  eraftkv::RequestVoteResp resp;
+  std::unique_ptr<grpc::ClientAsyncResponseReader<eraftkv::RequestVoteResp>>
+      response_reader;
+
+  void Complete(bool ok) override;
+};
+
 class GRpcNetworkImpl : public Network {
 
  public:
   /**
-   * @brief
+   * @brief Construct a new GRpcNetworkImpl object, start the completion
+   * queue polling thread
+   *
+   */
+  GRpcNetworkImpl();
+
+  /**
+   * @brief Destroy the GRpcNetworkImpl object, drain the completion queue
+   *
+   */
+  ~GRpcNetworkImpl();
+
+  /**
+   * @brief send a vote request without blocking, the response is handed to
+   * raft->HandleRequestVoteResp on the completion queue thread. the request
+   * is copied into the in flight call, caller still owns req
    *
    * @param raft
    * @param target_node
@@ -56,7 +121,9 @@ class GRpcNetworkImpl : public Network {
                           eraftkv::RequestVoteReq* req);
 
   /**
-   * @brief
+   * @brief send append entries without blocking, the response is handed to
+   * raft->HandleAppendEntriesResp on the completion queue thread. the request
+   * content is moved into the in flight call, caller still owns req
    *
    * @param raft
    * @param target_node
@@ -91,6 +158,20 @@ class GRpcNetworkImpl : public Network {
                    RaftNode*          raft_node,
                    const std::string& filename);
 
+  /**
+   * @brief
+   *
+   * @param raft
+   * @param target_node
+   * @param req
+   * @param resp
+   * @return EStatus
+   */
+  EStatus SendReadIndex(RaftServer*             raft,
+                        RaftNode*               target_node,
+                        eraftkv::ReadIndexReq*  req,
+                        eraftkv::ReadIndexResp* resp);
+
   /**
    * @brief
    *
@@ -116,10 +197,28 @@ class GRpcNetworkImpl : public Network {
    */
   EStatus InsertPeerNodeConnection(int64_t peer_id, std::string addr);
 
+  /**
+   * @brief loop on the completion queue and dispatch finished raft calls
+   *
+   */
+  void AsyncCompleteRpc();
+
  private:
   /**
    * @brief
    *
    */
   std::map<int64_t, std::unique_ptr<ERaftKv::Stub>> peer_node_connections_;
+
+  /**
+   * @brief completion queue shared by all async raft calls
+   *
+   */
+  grpc::CompletionQueue cq_;
+
+  /**
+   * @brief thread polling cq_
+   *
+   */
+  std::thread cq_thread_;
 };
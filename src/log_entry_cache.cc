@@ -33,13 +33,18 @@
 
 #include "log_entry_cache.h"
 
-#include <iostream>
+#include <string.h>
+
+#include <algorithm>
+
+#include "consts.h"
 
 /**
  * @brief Construct a new Log Entry Cache:: Log Entry Cache object
  *
  */
-LogEntryCache::LogEntryCache() : ent_count_(0), first_ent_index_(0) {}
+LogEntryCache::LogEntryCache()
+    : head_(0), first_ent_index_(0), data_size_(0), ent_count_(0) {}
 
 /**
  * @brief Destroy the Log Entry Cache:: Log Entry Cache object
@@ -48,48 +53,68 @@ LogEntryCache::LogEntryCache() : ent_count_(0), first_ent_index_(0) {}
 LogEntryCache::~LogEntryCache() {}
 
 /**
- * @brief append a log entry to cache
- *   !!! IMPORTTANT !!!
- *   we assume the first log entry id must > 0
+ * @brief append a copy of the log entry to cache, the entry is serialized
+ * straight into the ring buffer
+ *
  * @param e
  */
-void LogEntryCache::Append(eraftkv::Entry* e) {
-  // if first ent index not set, set it to e.id
-  if (!first_ent_index_) {
+void LogEntryCache::Append(const eraftkv::Entry* e) {
+  if (ent_count_ > 0) {
+    int64_t next_index = first_ent_index_ + static_cast<int64_t>(ent_count_);
+    if (e->id() != next_index) {
+      if (e->id() >= first_ent_index_ && e->id() < next_index) {
+        this->EraseTail(e->id());
+      } else {
+        this->Clear();
+      }
+    }
+  }
+  if (ent_count_ == 0) {
     first_ent_index_ = e->id();
   }
-
-  entries_.push_back(e);
-  /**
-   * @brief
-   *
-   * Recursively calls ByteSize() on all contained messages.
-   * Returns: The number of bytes required to serialize this message. Return
-   * type:.
-   *
-   */
+  uint64_t size = e->ByteSizeLong();
+  uint64_t offset = this->Reserve(size);
+  e->SerializeWithCachedSizesToArray(
+      reinterpret_cast<uint8_t*>(&data_[offset]));
+  LogEntryHeader* header = this->Header(ent_count_);
+  header->index = e->id();
+  header->term = e->term();
+  header->type = e->e_type();
+  header->size = size;
+  header->offset = offset;
   ent_count_ += 1;
-  mem_size_ += e->ByteSizeLong();
+  data_size_ += size;
 }
 
 /**
  * @brief get log entry from log entry cache with index = idx
  *
  * @param idx
- * @return eraftkv::Entry*
+ * @param e
+ * @return bool
  */
-eraftkv::Entry* LogEntryCache::Get(int64_t idx) {
+bool LogEntryCache::Get(int64_t idx, eraftkv::Entry* e) {
   // log cache has be compact, log with idx has already release
-  if (idx < first_ent_index_) {
-    return nullptr;
+  if (idx < first_ent_index_ ||
+      idx >= first_ent_index_ + static_cast<int64_t>(ent_count_)) {
+    return false;
   }
+  LogEntryHeader* header = this->Header(idx - first_ent_index_);
+  return e->ParseFromArray(&data_[header->offset], header->size);
+}
 
-  int64_t entry_offset = idx - first_ent_index_;
-  if (entry_offset >= ent_count_) {
-    return nullptr;
+/**
+ * @brief term of the cached entry with index = idx
+ *
+ * @param idx
+ * @return int64_t
+ */
+int64_t LogEntryCache::Term(int64_t idx) {
+  if (idx < first_ent_index_ ||
+      idx >= first_ent_index_ + static_cast<int64_t>(ent_count_)) {
+    return -1;
   }
-
-  return entries_.at(entry_offset);
+  return this->Header(idx - first_ent_index_)->term;
 }
 
 /**
@@ -103,10 +128,14 @@ int64_t LogEntryCache::EraseHead(int64_t idx) {
   if (idx < first_ent_index_) {
     return -1;
   }
-
-  auto begin_ent_it = entries_.begin();
-  auto elem_count = idx - first_ent_index_;
-  entries_.erase(begin_ent_it, begin_ent_it + elem_count);
+  uint64_t elem_count =
+      std::min<uint64_t>(idx - first_ent_index_, ent_count_);
+  for (uint64_t i = 0; i < elem_count; i++) {
+    data_size_ -= this->Header(i)->size;
+  }
+  if (elem_count > 0) {
+    head_ = (head_ + elem_count) % headers_.size();
+  }
   first_ent_index_ += elem_count;
   ent_count_ -= elem_count;
   return elem_count;
@@ -119,28 +148,56 @@ int64_t LogEntryCache::EraseHead(int64_t idx) {
  * @return int64_t
  */
 int64_t LogEntryCache::EraseTail(int64_t idx) {
-  if (idx >= first_ent_index_ + entries_.size()) {
+  if (idx >= first_ent_index_ + static_cast<int64_t>(ent_count_)) {
     return -1;
   }
   if (idx < first_ent_index_) {
     idx = first_ent_index_;
   }
-  auto end_ent_it = entries_.end();
-  auto elem_count = entries_.size() - (idx - first_ent_index_);
-  entries_.erase(end_ent_it - elem_count, end_ent_it);
+  uint64_t elem_count = ent_count_ - (idx - first_ent_index_);
+  for (uint64_t i = ent_count_ - elem_count; i < ent_count_; i++) {
+    data_size_ -= this->Header(i)->size;
+  }
   ent_count_ -= elem_count;
   return elem_count;
 }
 
 /**
- * @brief
+ * @brief erase the oldest entries until the cache fits in max_mem, the
+ * buffers are shrunk to twice the remaining size once they are four times
+ * larger
  *
  * @param max_mem
  * @return int64_t
  */
 int64_t LogEntryCache::Compact(int64_t max_mem) {
-  // TODO:
-  return -1;
+  int64_t elem_count = 0;
+  while (ent_count_ > 0 && this->MemSize() > static_cast<uint64_t>(max_mem)) {
+    this->EraseHead(first_ent_index_ + 1);
+    elem_count++;
+  }
+  uint64_t data_capacity =
+      std::max<uint64_t>(2 * data_size_, LOG_ENTRY_CACHE_INIT_SIZE);
+  uint64_t header_capacity =
+      std::max<uint64_t>(2 * ent_count_, LOG_ENTRY_CACHE_INIT_ENTRIES);
+  // shrink only well past the target so a cache hovering around a size
+  // does not repack on every call
+  if (data_.size() > 2 * data_capacity ||
+      headers_.size() > 2 * header_capacity) {
+    this->Repack(std::min<uint64_t>(data_.size(), data_capacity),
+                 std::min<uint64_t>(headers_.size(), header_capacity));
+  }
+  return elem_count;
+}
+
+/**
+ * @brief erase all the entries, the buffers are kept
+ *
+ */
+void LogEntryCache::Clear() {
+  head_ = 0;
+  data_size_ = 0;
+  ent_count_ = 0;
 }
 
 /**
@@ -149,7 +206,7 @@ int64_t LogEntryCache::Compact(int64_t max_mem) {
  * @return uint64_t
  */
 uint64_t LogEntryCache::MemSize() {
-  return mem_size_;
+  return data_size_ + ent_count_ * sizeof(LogEntryHeader);
 }
 
 /**
@@ -169,3 +226,64 @@ uint64_t LogEntryCache::EntryCount() {
 int64_t LogEntryCache::FirstIndex() {
   return first_ent_index_;
 }
+
+LogEntryHeader* LogEntryCache::Header(uint64_t i) {
+  return &headers_[(head_ + i) % headers_.size()];
+}
+
+/**
+ * @brief the entries are kept in ring order, a new entry goes after the
+ * last one, or wraps to the buffer start if the space before the first
+ * entry is large enough, otherwise the buffers are repacked to twice the
+ * size
+ *
+ * @param size
+ * @return uint64_t
+ */
+uint64_t LogEntryCache::Reserve(uint64_t size) {
+  if (ent_count_ == headers_.size()) {
+    this->Repack(data_.size(),
+                 std::max<uint64_t>(2 * headers_.size(),
+                                    LOG_ENTRY_CACHE_INIT_ENTRIES));
+  }
+  if (ent_count_ == 0) {
+    if (size > data_.size()) {
+      this->Repack(std::max<uint64_t>(
+                       {size, 2 * data_.size(), LOG_ENTRY_CACHE_INIT_SIZE}),
+                   headers_.size());
+    }
+    return 0;
+  }
+  LogEntryHeader* first = this->Header(0);
+  LogEntryHeader* last = this->Header(ent_count_ - 1);
+  uint64_t        end = last->offset + last->size;
+  if (last->offset >= first->offset) {
+    if (data_.size() - end >= size) {
+      return end;
+    }
+    if (first->offset >= size) {
+      return 0;
+    }
+  } else if (first->offset - end >= size) {
+    return end;
+  }
+  this->Repack(std::max<uint64_t>(2 * data_.size(), data_size_ + size),
+               headers_.size());
+  return data_size_;
+}
+
+void LogEntryCache::Repack(uint64_t data_capacity, uint64_t header_capacity) {
+  std::string                 data(data_capacity, '\0');
+  std::vector<LogEntryHeader> headers(header_capacity);
+  uint64_t                    offset = 0;
+  for (uint64_t i = 0; i < ent_count_; i++) {
+    LogEntryHeader header = *this->Header(i);
+    memcpy(&data[offset], &data_[header.offset], header.size);
+    header.offset = offset;
+    offset += header.size;
+    headers[i] = header;
+  }
+  data_.swap(data);
+  headers_.swap(headers);
+  head_ = 0;
+}
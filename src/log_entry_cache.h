@@ -34,11 +34,30 @@
 
 #include <stdint.h>
 
-#include <deque>
+#include <string>
+#include <vector>
 
 #include "eraftkv.pb.h"
 
+/**
+ * @brief fixed size header of a cached entry, the serialized entry is
+ * data_[offset, offset + size)
+ *
+ */
+struct LogEntryHeader {
+  int64_t  index;
+  int64_t  term;
+  int32_t  type;
+  uint32_t size;
+  uint64_t offset;
+};
 
+/**
+ * @brief cache of consecutive log entries, the serialized entries are kept
+ * in one ring byte buffer and their headers in a ring of fixed size
+ * headers, so appends and erases at both ends never allocate per entry
+ *
+ */
 class LogEntryCache {
 
  public:
@@ -55,27 +74,37 @@ class LogEntryCache {
   ~LogEntryCache();
 
   /**
-   * @brief append a log entry to cache
-   *   !!! IMPORTTANT !!!
-   *   we assume the first log entry id must > 0
+   * @brief append a copy of the log entry to cache, an entry that does not
+   * follow the last cached one replaces the cached entries from its index,
+   * or restarts the cache if its index is outside of them
+   *
    * @param e
    */
-  void Append(eraftkv::Entry* e);
+  void Append(const eraftkv::Entry* e);
 
   /**
    * @brief get log entry from log entry cache with index = idx
    *
    * @param idx
-   * @return eraftkv::Entry*
+   * @param e
+   * @return bool false if idx is not cached
    */
-  eraftkv::Entry* Get(int64_t idx);
+  bool Get(int64_t idx, eraftkv::Entry* e);
+
+  /**
+   * @brief term of the cached entry with index = idx
+   *
+   * @param idx
+   * @return int64_t -1 if idx is not cached
+   */
+  int64_t Term(int64_t idx);
 
   /**
    * @brief erase log entry with id < idx, idx is the first log of the remaining
    * log structure
    *
    * @param idx
-   * @return int64_t
+   * @return int64_t erased entry count, -1 if idx is before the cache
    */
   int64_t EraseHead(int64_t idx);
 
@@ -83,20 +112,28 @@ class LogEntryCache {
    * @brief erase all the log entries wiht index >= idx (including idx)
    *
    * @param idx
-   * @return int64_t
+   * @return int64_t erased entry count, -1 if idx is after the cache
    */
   int64_t EraseTail(int64_t idx);
 
   /**
-   * @brief
+   * @brief erase the oldest entries until MemSize() <= max_mem, oversized
+   * buffers are shrunk
    *
    * @param max_mem
-   * @return int64_t
+   * @return int64_t erased entry count
    */
   int64_t Compact(int64_t max_mem);
 
   /**
-   * @brief return the memsize of all log entries
+   * @brief erase all the entries
+   *
+   */
+  void Clear();
+
+  /**
+   * @brief return the memsize of all log entries, the serialized entries
+   * and their headers
    *
    * @return uint64_t
    */
@@ -118,10 +155,44 @@ class LogEntryCache {
 
  private:
   /**
-   * @brief
+   * @brief header of the i-th cached entry
+   *
+   * @param i
+   * @return LogEntryHeader*
+   */
+  LogEntryHeader* Header(uint64_t i);
+
+  /**
+   * @brief find buffer space for size more bytes after the last entry,
+   * growing the buffers if needed
    *
+   * @param size
+   * @return uint64_t offset of the space in data_
    */
-  std::deque<eraftkv::Entry*> entries_;
+  uint64_t Reserve(uint64_t size);
+
+  /**
+   * @brief move the entries to new buffers of the given capacity, in order
+   * from offset 0
+   *
+   * @param data_capacity
+   * @param header_capacity
+   */
+  void Repack(uint64_t data_capacity, uint64_t header_capacity);
+
+  /**
+   * @brief ring of serialized entries
+   *
+   */
+  std::string data_;
+
+  /**
+   * @brief ring of entry headers, headers_[head_] is the first entry
+   *
+   */
+  std::vector<LogEntryHeader> headers_;
+
+  uint64_t head_;
 
   /**
    * @brief
@@ -130,10 +201,10 @@ class LogEntryCache {
   int64_t first_ent_index_;
 
   /**
-   * @brief
+   * @brief bytes of the serialized entries
    *
    */
-  uint64_t mem_size_;
+  uint64_t data_size_;
 
   /**
    * @brief
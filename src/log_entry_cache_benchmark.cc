@@ -37,26 +37,134 @@
 #include "log_entry_cache.h"
 
 /**
- * @brief
+ * @brief fill log_cache with count entries of payload_size bytes from index 1
+ *
+ * @param log_cache
+ * @param count
+ * @param payload_size
+ */
+static void FillLogCache(LogEntryCache* log_cache,
+                         int64_t        count,
+                         int64_t        payload_size) {
+  eraftkv::Entry ent;
+  ent.set_term(1);
+  ent.set_e_type(eraftkv::EntryType::Normal);
+  ent.set_data(std::string(payload_size, 'x'));
+  for (int64_t i = 1; i <= count; i++) {
+    ent.set_id(i);
+    log_cache->Append(&ent);
+  }
+}
+
+/**
+ * @brief append to a sliding window of 4096 entries, range(0) is the
+ * payload size
  *
  * @param state
  */
 static void BM_LogCacheAppend(benchmark::State& state) {
-  LogEntryCache*  log_cache = new LogEntryCache();
-  eraftkv::Entry* ent = new eraftkv::Entry();
-  ent->set_id(6);
-  ent->set_term(1);
-  ent->set_e_type(eraftkv::EntryType::Normal);
-  ent->set_data(
-      "48b29fd8d7828b3a3a71e1c9eb2661a140bb3e185552ef2d5c0292f816ed0e36");
+  LogEntryCache* log_cache = new LogEntryCache();
+  eraftkv::Entry ent;
+  ent.set_term(1);
+  ent.set_e_type(eraftkv::EntryType::Normal);
+  ent.set_data(std::string(state.range(0), 'x'));
+  int64_t index = 1;
+  for (auto _ : state) {
+    ent.set_id(index);
+    log_cache->Append(&ent);
+    if (index > 4096) {
+      log_cache->EraseHead(index - 4095);
+    }
+    index++;
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  delete log_cache;
+}
+
+BENCHMARK(BM_LogCacheAppend)->Arg(64)->Arg(1 << 10)->Arg(16 << 10);
 
+/**
+ * @brief random reads of 4096 cached entries, range(0) is the payload size
+ *
+ * @param state
+ */
+static void BM_LogCacheGet(benchmark::State& state) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  FillLogCache(log_cache, 4096, state.range(0));
+  eraftkv::Entry ent;
+  uint64_t       seed = 1;
   for (auto _ : state) {
-    log_cache->Append(ent);
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    benchmark::DoNotOptimize(log_cache->Get(1 + (seed >> 33) % 4096, &ent));
   }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  delete log_cache;
+}
 
+BENCHMARK(BM_LogCacheGet)->Arg(64)->Arg(1 << 10)->Arg(16 << 10);
+
+/**
+ * @brief release the applied head of 4096 entries in steps of range(0)
+ *
+ * @param state
+ */
+static void BM_LogCacheEraseHead(benchmark::State& state) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  for (auto _ : state) {
+    state.PauseTiming();
+    FillLogCache(log_cache, 4096, 1 << 10);
+    state.ResumeTiming();
+    for (int64_t i = 1; i <= 4096; i += state.range(0)) {
+      log_cache->EraseHead(i);
+    }
+  }
+  delete log_cache;
+}
+
+BENCHMARK(BM_LogCacheEraseHead)->Arg(1)->Arg(64);
+
+/**
+ * @brief truncate the last range(0) of 4096 entries and append them again
+ *
+ * @param state
+ */
+static void BM_LogCacheEraseTail(benchmark::State& state) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  FillLogCache(log_cache, 4096, 1 << 10);
+  eraftkv::Entry ent;
+  ent.set_term(2);
+  ent.set_data(std::string(1 << 10, 'x'));
+  for (auto _ : state) {
+    log_cache->EraseTail(4097 - state.range(0));
+    state.PauseTiming();
+    for (int64_t i = 4097 - state.range(0); i <= 4096; i++) {
+      ent.set_id(i);
+      log_cache->Append(&ent);
+    }
+    state.ResumeTiming();
+  }
+  delete log_cache;
+}
+
+BENCHMARK(BM_LogCacheEraseTail)->Arg(1)->Arg(64)->Arg(1024);
+
+/**
+ * @brief evict 16384 entries of 1KB down to range(0) bytes
+ *
+ * @param state
+ */
+static void BM_LogCacheCompact(benchmark::State& state) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  for (auto _ : state) {
+    state.PauseTiming();
+    log_cache->Clear();
+    FillLogCache(log_cache, 16384, 1 << 10);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(log_cache->Compact(state.range(0)));
+  }
   delete log_cache;
 }
 
-BENCHMARK(BM_LogCacheAppend);
+BENCHMARK(BM_LogCacheCompact)->Arg(1 << 20)->Arg(8 << 20);
 
 BENCHMARK_MAIN();
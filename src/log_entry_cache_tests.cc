@@ -75,11 +75,14 @@ TEST(LogEntryCacheTest, GetEntry) {
   ent_3->set_data("testv3");
   log_cache->Append(ent_3);
   ASSERT_EQ(6, log_cache->FirstIndex());
-  auto got_ent = log_cache->Get(7);
-  ASSERT_EQ(7, got_ent->id());
-  ASSERT_EQ(1, got_ent->term());
-  ASSERT_EQ("testv2", got_ent->data());
-  ASSERT_EQ(eraftkv::EntryType::Normal, got_ent->e_type());
+  eraftkv::Entry got_ent;
+  ASSERT_TRUE(log_cache->Get(7, &got_ent));
+  ASSERT_EQ(7, got_ent.id());
+  ASSERT_EQ(1, got_ent.term());
+  ASSERT_EQ("testv2", got_ent.data());
+  ASSERT_EQ(eraftkv::EntryType::Normal, got_ent.e_type());
+  ASSERT_EQ(1, log_cache->Term(8));
+  ASSERT_FALSE(log_cache->Get(9, &got_ent));
   delete log_cache;
 }
 
@@ -131,8 +134,81 @@ TEST(LogEntryCacheTest, EraseTail) {
   log_cache->EraseTail(7);
   ASSERT_EQ(6, log_cache->FirstIndex());
   ASSERT_EQ(1, log_cache->EntryCount());
-  ASSERT_EQ(nullptr, log_cache->Get(7));
-  ASSERT_EQ(nullptr, log_cache->Get(8));
+  eraftkv::Entry got_ent;
+  ASSERT_FALSE(log_cache->Get(7, &got_ent));
+  ASSERT_FALSE(log_cache->Get(8, &got_ent));
+  delete log_cache;
+}
+
+TEST(LogEntryCacheTest, AppendOverwrite) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  eraftkv::Entry ent;
+  for (int64_t i = 1; i <= 5; i++) {
+    ent.set_id(i);
+    ent.set_term(1);
+    log_cache->Append(&ent);
+  }
+  // a conflicting entry replaces the cached tail from its index
+  ent.set_id(3);
+  ent.set_term(2);
+  log_cache->Append(&ent);
+  ASSERT_EQ(3, log_cache->EntryCount());
+  ASSERT_EQ(2, log_cache->Term(3));
+  // an entry after a gap restarts the cache
+  ent.set_id(10);
+  log_cache->Append(&ent);
+  ASSERT_EQ(1, log_cache->EntryCount());
+  ASSERT_EQ(10, log_cache->FirstIndex());
+  delete log_cache;
+}
+
+TEST(LogEntryCacheTest, RingWrapAround) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  eraftkv::Entry ent;
+  ent.set_term(1);
+  ent.set_data(std::string(1000, 'x'));
+  // keep a sliding window of entries so the ring wraps many times
+  for (int64_t i = 1; i <= 2000; i++) {
+    ent.set_id(i);
+    log_cache->Append(&ent);
+    if (i > 50) {
+      log_cache->EraseHead(i - 49);
+    }
+  }
+  ASSERT_EQ(50, log_cache->EntryCount());
+  ASSERT_EQ(1951, log_cache->FirstIndex());
+  eraftkv::Entry got_ent;
+  for (int64_t i = 1951; i <= 2000; i++) {
+    ASSERT_TRUE(log_cache->Get(i, &got_ent));
+    ASSERT_EQ(i, got_ent.id());
+    ASSERT_EQ(1000, got_ent.data().size());
+  }
+  delete log_cache;
+}
+
+TEST(LogEntryCacheTest, MemSizeCompact) {
+  LogEntryCache* log_cache = new LogEntryCache();
+  eraftkv::Entry ent;
+  ent.set_term(1);
+  ent.set_data(std::string(100, 'x'));
+  uint64_t mem_size = 0;
+  for (int64_t i = 1; i <= 100; i++) {
+    ent.set_id(i);
+    log_cache->Append(&ent);
+    mem_size += ent.ByteSizeLong() + sizeof(LogEntryHeader);
+  }
+  ASSERT_EQ(mem_size, log_cache->MemSize());
+  ent.set_id(100);
+  uint64_t ent_size = ent.ByteSizeLong() + sizeof(LogEntryHeader);
+  ASSERT_EQ(90, log_cache->Compact(10 * ent_size));
+  ASSERT_EQ(10, log_cache->EntryCount());
+  ASSERT_EQ(91, log_cache->FirstIndex());
+  ASSERT_EQ(10 * ent_size, log_cache->MemSize());
+  eraftkv::Entry got_ent;
+  ASSERT_TRUE(log_cache->Get(100, &got_ent));
+  ASSERT_EQ(100, got_ent.id());
+  log_cache->EraseTail(91);
+  ASSERT_EQ(0, log_cache->MemSize());
   delete log_cache;
 }
 
@@ -31,12 +31,17 @@
  *
  */
 
+#include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
+#include <rocksdb/table.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
+#include <rocksdb/write_batch.h>
 #include <spdlog/spdlog.h>
 #include <stdint.h>
 
 #include <iostream>
 
+#include "consts.h"
 #include "rocksdb_storage_impl.h"
 #include "util.h"
 
@@ -58,13 +63,109 @@ void RocksDBSingleLogStorageImpl::ResetFirstIndex(int64_t new_idx) {
  * @return EStatus
  */
 EStatus RocksDBSingleLogStorageImpl::Append(eraftkv::Entry* ety) {
-  std::string key;
-  key.append("E:");
-  EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(ety->id()));
+  std::string key = this->EntryKey(ety->id());
   std::string val = ety->SerializeAsString();
-  auto        st = log_db_->Put(rocksdb::WriteOptions(), key, val);
+  auto        st =
+      log_db_->Put(rocksdb::WriteOptions(), this->entry_cf_, key, val);
   assert(st.ok());
   this->last_idx = ety->id();
+  this->CacheEntries({ety});
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.Append(ety->id(), ety->term());
+  return EStatus::kOk;
+}
+
+/**
+ * @brief AppendBatch add a batch of new entries in one rocksdb write batch
+ * with a single sync
+ *
+ * @param etys
+ * @return EStatus
+ */
+EStatus RocksDBSingleLogStorageImpl::AppendBatch(
+    const std::vector<eraftkv::Entry*>& etys) {
+  return this->AppendEntries(etys, false, 0, 0);
+}
+
+/**
+ * @brief AppendBatch add a batch of new entries together with the log meta
+ * state in one rocksdb write batch with a single sync, a crash never leaves
+ * the entries without their LAST_IDX
+ *
+ * @param etys
+ * @param commit_idx
+ * @param applied_idx
+ * @return EStatus
+ */
+EStatus RocksDBSingleLogStorageImpl::AppendBatch(
+    const std::vector<eraftkv::Entry*>& etys,
+    int64_t                             commit_idx,
+    int64_t                             applied_idx) {
+  return this->AppendEntries(etys, true, commit_idx, applied_idx);
+}
+
+/**
+ * @brief entries the log already holds with the same term are skipped, the
+ * rest is written from the first new or conflicting entry on. the last
+ * index only moves when an entry is written, so a stale or resent batch
+ * leaves the log as it is
+ *
+ * @param etys
+ * @param with_meta
+ * @param commit_idx
+ * @param applied_idx
+ * @return EStatus
+ */
+EStatus RocksDBSingleLogStorageImpl::AppendEntries(
+    const std::vector<eraftkv::Entry*>& etys,
+    bool                                with_meta,
+    int64_t                             commit_idx,
+    int64_t                             applied_idx) {
+  std::vector<eraftkv::Entry*> new_etys;
+  {
+    std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+    for (auto ety : etys) {
+      if (new_etys.empty() &&
+          (ety->id() < this->first_idx ||
+           (ety->id() <= this->last_idx &&
+            this->term_index_.Term(ety->id()) == ety->term()))) {
+        continue;
+      }
+      new_etys.push_back(ety);
+    }
+  }
+  if (new_etys.empty()) {
+    return EStatus::kOk;
+  }
+  rocksdb::WriteBatch batch;
+  std::string         key;
+  std::string         val;
+  for (auto ety : new_etys) {
+    key = this->EntryKey(ety->id());
+    ety->SerializeToString(&val);
+    batch.Put(this->entry_cf_, key, val);
+  }
+  // an entry written at or below the last index is a conflict, the old
+  // entries after the batch are dropped with it
+  int64_t last_idx = new_etys.back()->id();
+  if (with_meta) {
+    this->PutLogMetaState(&batch, commit_idx, applied_idx, last_idx);
+  }
+  rocksdb::WriteOptions write_options;
+  write_options.sync = true;
+  auto st = log_db_->Write(write_options, &batch);
+  if (!st.ok()) {
+    SPDLOG_ERROR("append batch of {} entries failed {}",
+                 new_etys.size(),
+                 st.ToString());
+    return EStatus::kError;
+  }
+  this->last_idx = last_idx;
+  this->CacheEntries(new_etys);
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  for (auto ety : new_etys) {
+    this->term_index_.Append(ety->id(), ety->term());
+  }
   return EStatus::kOk;
 }
 
@@ -77,14 +178,19 @@ EStatus RocksDBSingleLogStorageImpl::Append(eraftkv::Entry* ety) {
  */
 EStatus RocksDBSingleLogStorageImpl::EraseBefore(int64_t first_index) {
   int64_t old_fir_idx = this->first_idx;
-  for (int64_t i = old_fir_idx; i < first_index; i++) {
-    std::string key;
-    key.append("E:");
-    EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(i));
-    auto st = log_db_->Delete(rocksdb::WriteOptions(), key);
-    assert(st.ok());
+  // entries below first_idx are never read again, so their deletes can be
+  // left to the gc thread
+  auto st = this->DeleteEntries(old_fir_idx, first_index, true);
+  if (st != EStatus::kOk) {
+    return st;
   }
   this->first_idx = first_index;
+  {
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    this->entry_cache_.EraseHead(first_index);
+  }
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.CompactTo(first_index);
   return EStatus::kOk;
 }
 
@@ -96,14 +202,19 @@ EStatus RocksDBSingleLogStorageImpl::EraseBefore(int64_t first_index) {
  * @return EStatus
  */
 EStatus RocksDBSingleLogStorageImpl::EraseAfter(int64_t from_index) {
-  for (int64_t i = from_index; i <= this->last_idx; i++) {
-    std::string key;
-    key.append("E:");
-    EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(i));
-    auto st = log_db_->Delete(rocksdb::WriteOptions(), key);
-    assert(st.ok());
+  // the truncated indexes are appended again right after, so the deletes
+  // must land before returning
+  auto st = this->DeleteEntries(from_index, this->last_idx + 1, false);
+  if (st != EStatus::kOk) {
+    return st;
   }
   this->last_idx = from_index;
+  {
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    this->entry_cache_.EraseTail(from_index);
+  }
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.TruncateFrom(this->last_idx + 1);
   return EStatus::kOk;
 }
 
@@ -115,61 +226,186 @@ EStatus RocksDBSingleLogStorageImpl::EraseAfter(int64_t from_index) {
  * @return EStatus
  */
 EStatus RocksDBSingleLogStorageImpl::EraseRange(int64_t start, int64_t end) {
-  for (int64_t i = start; i < end; i++) {
-    std::string key;
-    key.append("E:");
-    EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(i));
-    auto st = log_db_->Delete(rocksdb::WriteOptions(), key);
-    assert(st.ok());
-  }
-  return EStatus::kOk;
+  return this->DeleteEntries(start, end, false);
 }
 
 /**
- * @brief Get get the given index entry
+ * @brief Get read the given index entry into ety, the log db value is
+ * parsed in place from a pinned slice
  *
  * @param index
- * @return eraftkv::Entry*
+ * @param ety
+ * @return EStatus
  */
-eraftkv::Entry* RocksDBSingleLogStorageImpl::Get(int64_t index) {
-  eraftkv::Entry* new_ety = new eraftkv::Entry();
-  std::string     new_ety_str;
-  std::string     key;
-  key.append("E:");
-  EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(index));
-  auto status = log_db_->Get(rocksdb::ReadOptions(), key, &new_ety_str);
-  // assert(status.ok());
-  if (status.ok()) {
-    bool parse_ok = new_ety->ParseFromString(new_ety_str);
+EStatus RocksDBSingleLogStorageImpl::Get(int64_t index, eraftkv::Entry* ety) {
+  if (this->GetCached(index, ety)) {
+    return EStatus::kOk;
+  }
+  rocksdb::PinnableSlice value;
+  rocksdb::Status        status = log_db_->Get(rocksdb::ReadOptions(),
+                                               this->entry_cf_,
+                                               this->EntryKey(index),
+                                               &value);
+  if (!status.ok() || !ety->ParseFromArray(value.data(), value.size())) {
+    ety->Clear();
+    return EStatus::kNotFound;
   }
-  // assert(parse_ok);
-  return new_ety;
+  return EStatus::kOk;
 }
 
 /**
- * @brief Gets get the given index range entry
+ * @brief Gets read the entries in [start_index, end_index] into entries,
+ * a range ending in the entry cache takes its cached part from there and
+ * the rest with one batched multi get, the entry objects already in entries
+ * are reused
  *
  * @param start_index
  * @param end_index
- * @return std::vector<eraftkv::Entry*>
+ * @param entries
+ * @return EStatus
  */
-std::vector<eraftkv::Entry*> RocksDBSingleLogStorageImpl::Gets(
-    int64_t start_index,
-    int64_t end_index) {
-  std::vector<eraftkv::Entry*> entries;
-  for (int64_t i = start_index; i <= end_index; i++) {
-    auto ety = this->Get(i);
-    entries.push_back(ety);
+EStatus RocksDBSingleLogStorageImpl::Gets(
+    int64_t                      start_index,
+    int64_t                      end_index,
+    std::vector<eraftkv::Entry>* entries) {
+  if (end_index < start_index) {
+    entries->clear();
+    return EStatus::kOk;
+  }
+  size_t count = end_index - start_index + 1;
+  size_t disk_count = count;
+  entries->resize(count);
+  {
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    int64_t cache_first = this->entry_cache_.FirstIndex();
+    int64_t cache_last = cache_first + this->entry_cache_.EntryCount() - 1;
+    if (this->entry_cache_.EntryCount() > 0 && cache_first <= end_index &&
+        cache_last >= end_index) {
+      int64_t from = std::max(start_index, cache_first);
+      disk_count = from - start_index;
+      for (int64_t i = from; i <= end_index; i++) {
+        this->entry_cache_.Get(i, &(*entries)[i - start_index]);
+      }
+    }
+  }
+  if (disk_count == 0) {
+    return EStatus::kOk;
   }
-  return entries;
+  return this->ScanEntries(start_index, disk_count, entries);
 }
 
-eraftkv::Entry* RocksDBSingleLogStorageImpl::GetFirstEty() {
-  return this->Get(this->first_idx);
+EStatus RocksDBSingleLogStorageImpl::ScanEntries(
+    int64_t                      start_index,
+    size_t                       count,
+    std::vector<eraftkv::Entry>* entries) {
+  std::string          end_key = this->EntryKey(start_index + count);
+  rocksdb::Slice       upper_bound(end_key);
+  rocksdb::ReadOptions read_options;
+  read_options.iterate_upper_bound = &upper_bound;
+  // a lagging follower reads long runs of entries
+  read_options.readahead_size = LOG_ENTRY_READAHEAD_SIZE;
+  auto   iter = log_db_->NewIterator(read_options, this->entry_cf_);
+  size_t i = 0;
+  for (iter->Seek(this->EntryKey(start_index)); iter->Valid() && i < count;
+       iter->Next(), i++) {
+    // a gap in the keys is a missing entry
+    const uint8_t* key =
+        reinterpret_cast<const uint8_t*>(iter->key().data());
+    uint64_t index =
+        EncodeDecodeTool::DecodeBigEndian64(key + iter->key().size() - 8);
+    if (index != static_cast<uint64_t>(start_index + i) ||
+        !(*entries)[i].ParseFromArray(iter->value().data(),
+                                      iter->value().size())) {
+      break;
+    }
+  }
+  delete iter;
+  if (i < count) {
+    entries->resize(i);
+    return EStatus::kNotFound;
+  }
+  return EStatus::kOk;
 }
 
-eraftkv::Entry* RocksDBSingleLogStorageImpl::GetLastEty() {
-  return this->Get(this->last_idx);
+EStatus RocksDBSingleLogStorageImpl::GetFirstEty(eraftkv::Entry* ety) {
+  return this->Get(this->first_idx, ety);
+}
+
+EStatus RocksDBSingleLogStorageImpl::GetLastEty(eraftkv::Entry* ety) {
+  return this->Get(this->last_idx, ety);
+}
+
+/**
+ * @brief Term get the term of the given index entry from the in memory term
+ * index, entries outside of the index are read from the log db
+ *
+ * @param index
+ * @return int64_t
+ */
+int64_t RocksDBSingleLogStorageImpl::Term(int64_t index) {
+  {
+    std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+    int64_t                     term = this->term_index_.Term(index);
+    if (term != -1) {
+      return term;
+    }
+  }
+  eraftkv::Entry ety;
+  this->Get(index, &ety);
+  return ety.term();
+}
+
+/**
+ * @brief LastTerm get the term of the last entry
+ *
+ * @return int64_t
+ */
+int64_t RocksDBSingleLogStorageImpl::LastTerm() {
+  return this->Term(this->last_idx);
+}
+
+/**
+ * @brief FirstIndexOfTerm get the first index of the given term from the in
+ * memory term index
+ *
+ * @param term
+ * @return int64_t
+ */
+int64_t RocksDBSingleLogStorageImpl::FirstIndexOfTerm(int64_t term) {
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  return this->term_index_.FirstIndexOfTerm(term);
+}
+
+/**
+ * @brief LastIndexOfTerm get the last index of the given term from the in
+ * memory term index
+ *
+ * @param term
+ * @return int64_t
+ */
+int64_t RocksDBSingleLogStorageImpl::LastIndexOfTerm(int64_t term) {
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  return this->term_index_.LastIndexOfTerm(term);
+}
+
+void RocksDBSingleLogStorageImpl::RebuildTermIndex() {
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.Clear();
+  std::string          end_key = this->EntryKey(this->last_idx + 1);
+  rocksdb::Slice       upper_bound(end_key);
+  rocksdb::ReadOptions read_options;
+  read_options.iterate_upper_bound = &upper_bound;
+  read_options.readahead_size = LOG_ENTRY_READAHEAD_SIZE;
+  auto iter = log_db_->NewIterator(read_options, this->entry_cf_);
+  for (iter->Seek(this->EntryKey(this->first_idx)); iter->Valid();
+       iter->Next()) {
+    eraftkv::Entry ety;
+    if (!ety.ParseFromArray(iter->value().data(), iter->value().size())) {
+      continue;
+    }
+    this->term_index_.Append(ety.id(), ety.term());
+  }
+  delete iter;
 }
 
 /**
@@ -196,13 +432,24 @@ void RocksDBSingleLogStorageImpl::ResetFirstLogEntry(int64_t term,
   ety->set_e_type(eraftkv::EntryType::NoOp);
   ety->set_id(index);
   ety->set_term(term);
-  std::string* key = new std::string();
-  key->append("E:");
-  EncodeDecodeTool::PutFixed64(key, static_cast<uint64_t>(index));
+  std::string key = this->EntryKey(index);
   std::string val = ety->SerializeAsString();
-  auto        status = log_db_->Put(rocksdb::WriteOptions(), *key, val);
+  auto        status =
+      log_db_->Put(rocksdb::WriteOptions(), this->entry_cf_, key, val);
+  delete ety;
   this->first_idx = index;
+  // after a reinit the snapshot entry is the whole log
+  if (this->last_idx < index) {
+    this->last_idx = index;
+  }
   assert(status.ok());
+  {
+    // the cached copy of index is replaced by the noop entry on disk
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    this->entry_cache_.EraseHead(index + 1);
+  }
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.ResetFirst(index, term);
 }
 
 /**
@@ -215,19 +462,36 @@ int64_t RocksDBSingleLogStorageImpl::LastIndex() {
 }
 
 EStatus RocksDBSingleLogStorageImpl::Reinit() {
-  rocksdb::ReadOptions read_options;
-  auto                 iter = log_db_->NewIterator(read_options);
-  iter->Seek("E:");
-  while (iter->Valid()) {
-    if (iter->key().ToString().rfind("E:", 0) == 0) {
-      auto st = log_db_->Delete(rocksdb::WriteOptions(), iter->key());
-      SPDLOG_INFO("delete log entry {}", iter->key().ToString());
-    }
-    iter->Next();
+  // all the entry keys of this log sort between "I:" and "I;", one range
+  // tombstone drops them
+  std::string begin = this->key_prefix_ + "I:";
+  std::string end = this->key_prefix_ + "I;";
+  auto        st = log_db_->DeleteRange(
+      rocksdb::WriteOptions(), this->entry_cf_, begin, end);
+  if (!st.ok()) {
+    SPDLOG_ERROR("delete log entries failed {}", st.ToString());
+    return EStatus::kError;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    this->entry_cache_.Clear();
   }
+  std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+  this->term_index_.Clear();
   return EStatus::kOk;
 }
 
+/**
+ * @brief ReleaseCache drop the cached entries with id < index, they are
+ * applied and replicated, later reads of them go to the log db
+ *
+ * @param index
+ */
+void RocksDBSingleLogStorageImpl::ReleaseCache(int64_t index) {
+  std::lock_guard<std::mutex> lock(this->cache_mutex_);
+  this->entry_cache_.EraseHead(index);
+}
+
 /**
  * @brief LogCount get the number of entries
  *
@@ -239,67 +503,80 @@ int64_t RocksDBSingleLogStorageImpl::LogCount() {
 
 EStatus RocksDBSingleLogStorageImpl::PersisLogMetaState(int64_t commit_idx,
                                                         int64_t applied_idx) {
-  auto status = log_db_->Put(
-      rocksdb::WriteOptions(), "M:COMMIT_IDX", std::to_string(commit_idx));
-  if (!status.ok()) {
-    return EStatus::kError;
-  }
-  status = log_db_->Put(
-      rocksdb::WriteOptions(), "M:APPLIED_IDX", std::to_string(applied_idx));
-  if (!status.ok()) {
-    return EStatus::kError;
-  }
-  status = log_db_->Put(
-      rocksdb::WriteOptions(), "M:FIRST_IDX", std::to_string(this->first_idx));
-  if (!status.ok()) {
-    return EStatus::kError;
-  }
-  status = log_db_->Put(
-      rocksdb::WriteOptions(), "M:LAST_IDX", std::to_string(this->last_idx));
-  if (!status.ok()) {
-    return EStatus::kError;
-  }
-  status = log_db_->Put(rocksdb::WriteOptions(),
-                        "M:SNAP_IDX",
-                        std::to_string(this->snapshot_idx));
+  rocksdb::WriteBatch batch;
+  this->PutLogMetaState(&batch, commit_idx, applied_idx, this->last_idx);
+  auto status = log_db_->Write(rocksdb::WriteOptions(), &batch);
   if (!status.ok()) {
     return EStatus::kError;
   }
   return EStatus::kOk;
 }
 
+void RocksDBSingleLogStorageImpl::PutLogMetaState(rocksdb::WriteBatch* batch,
+                                                  int64_t commit_idx,
+                                                  int64_t applied_idx,
+                                                  int64_t last_index) {
+  batch->Put(this->meta_cf_,
+             this->MetaKey("COMMIT_IDX"),
+             std::to_string(commit_idx));
+  batch->Put(this->meta_cf_,
+             this->MetaKey("APPLIED_IDX"),
+             std::to_string(applied_idx));
+  batch->Put(this->meta_cf_,
+             this->MetaKey("FIRST_IDX"),
+             std::to_string(this->first_idx));
+  batch->Put(this->meta_cf_,
+             this->MetaKey("LAST_IDX"),
+             std::to_string(last_index));
+  batch->Put(this->meta_cf_,
+             this->MetaKey("SNAP_IDX"),
+             std::to_string(this->snapshot_idx));
+}
+
 EStatus RocksDBSingleLogStorageImpl::ReadMetaState(int64_t* commit_idx,
                                                    int64_t* applied_idx) {
   try {
     std::string commit_idx_str;
-    auto        status =
-        log_db_->Get(rocksdb::ReadOptions(), "M:COMMIT_IDX", &commit_idx_str);
+    auto        status = log_db_->Get(rocksdb::ReadOptions(),
+                                      this->meta_cf_,
+                                      this->MetaKey("COMMIT_IDX"),
+                                      &commit_idx_str);
     *commit_idx = static_cast<int64_t>(stoi(commit_idx_str));
     if (!status.ok()) {
       return EStatus::kError;
     }
     std::string applied_idx_str;
-    status =
-        log_db_->Get(rocksdb::ReadOptions(), "M:APPLIED_IDX", &applied_idx_str);
+    status = log_db_->Get(rocksdb::ReadOptions(),
+                          this->meta_cf_,
+                          this->MetaKey("APPLIED_IDX"),
+                          &applied_idx_str);
     *applied_idx = static_cast<int64_t>(stoi(applied_idx_str));
     if (!status.ok()) {
       return EStatus::kError;
     }
     std::string first_idx_str;
-    status =
-        log_db_->Get(rocksdb::ReadOptions(), "M:FIRST_IDX", &first_idx_str);
+    status = log_db_->Get(rocksdb::ReadOptions(),
+                          this->meta_cf_,
+                          this->MetaKey("FIRST_IDX"),
+                          &first_idx_str);
     if (!status.ok()) {
       return EStatus::kError;
     }
     this->first_idx = static_cast<int64_t>(stoi(first_idx_str));
     std::string last_idx_str;
-    status = log_db_->Get(rocksdb::ReadOptions(), "M:LAST_IDX", &last_idx_str);
+    status = log_db_->Get(rocksdb::ReadOptions(),
+                          this->meta_cf_,
+                          this->MetaKey("LAST_IDX"),
+                          &last_idx_str);
     if (!status.ok()) {
       return EStatus::kError;
     }
     this->last_idx = static_cast<int64_t>(stoi(last_idx_str));
     std::string snap_idx_str;
-    status = log_db_->Get(rocksdb::ReadOptions(), "M:SNAP_IDX", &snap_idx_str);
+    status = log_db_->Get(rocksdb::ReadOptions(),
+                          this->meta_cf_,
+                          this->MetaKey("SNAP_IDX"),
+                          &snap_idx_str);
     if (!status.ok()) {
       return EStatus::kError;
     }
@@ -312,29 +589,371 @@ EStatus RocksDBSingleLogStorageImpl::ReadMetaState(int64_t* commit_idx,
   return EStatus::kOk;
 }
 
-RocksDBSingleLogStorageImpl::RocksDBSingleLogStorageImpl(std::string db_path)
-    : first_idx(0), last_idx(0), snapshot_idx(0) {
-  rocksdb::Options options;
-  options.create_if_missing = true;
-  rocksdb::Status status = rocksdb::DB::Open(options, db_path, &log_db_);
-  ("DEBUG: ", "init log db success with path ", db_path);
+RocksDBSingleLogStorageImpl::RocksDBSingleLogStorageImpl(
+    std::string db_path,
+    std::string entry_cf_options)
+    : first_idx(0)
+    , last_idx(0)
+    , snapshot_idx(0)
+    , gc_running_(false)
+    , owns_log_db_(true) {
+  LogDb log_db;
+  auto  st = OpenLogDb(db_path, entry_cf_options, &log_db);
+  assert(st == EStatus::kOk);
+  this->log_db_ = log_db.db;
+  this->entry_cf_ = log_db.entry_cf;
+  this->meta_cf_ = log_db.meta_cf;
+  SPDLOG_INFO("init log db success with path {}", db_path);
+  this->InitLogState();
+}
+
+/**
+ * @brief Construct a log storage on a log db shared with other raft groups,
+ * all the keys of this log are prefixed with key_prefix
+ *
+ * @param log_db
+ * @param key_prefix
+ */
+RocksDBSingleLogStorageImpl::RocksDBSingleLogStorageImpl(LogDb       log_db,
+                                                         std::string key_prefix)
+    : first_idx(0)
+    , last_idx(0)
+    , snapshot_idx(0)
+    , gc_running_(false)
+    , key_prefix_(key_prefix)
+    , owns_log_db_(false)
+    , log_db_(log_db.db)
+    , entry_cf_(log_db.entry_cf)
+    , meta_cf_(log_db.meta_cf) {
+  this->InitLogState();
+}
+
+void RocksDBSingleLogStorageImpl::InitLogState() {
+  auto st = this->MigrateEntryKeys();
+  assert(st == EStatus::kOk);
   // if not log meta, init log
   int64_t commit_idx, applied_idx;
   auto    est = ReadMetaState(&commit_idx, &applied_idx);
   if (est == EStatus::kError) {
     eraftkv::Entry* ety = new eraftkv::Entry();
     // write init log with index 0 to rocksdb
-    std::string* key = new std::string();
-    key->append("E:");
-    EncodeDecodeTool::PutFixed64(key, static_cast<uint64_t>(0));
+    std::string key = this->EntryKey(0);
     std::string val = ety->SerializeAsString();
-    auto        status = log_db_->Put(rocksdb::WriteOptions(), *key, val);
+    auto        status =
+        log_db_->Put(rocksdb::WriteOptions(), this->entry_cf_, key, val);
     assert(status.ok());
-    delete key;
     delete ety;
+    std::lock_guard<std::mutex> lock(this->term_index_mutex_);
+    this->term_index_.Append(0, 0);
+  } else {
+    this->RebuildTermIndex();
   }
 }
 
 RocksDBSingleLogStorageImpl::~RocksDBSingleLogStorageImpl() {
-  delete log_db_;
+  {
+    std::lock_guard<std::mutex> lock(this->gc_mutex_);
+    this->gc_running_ = false;
+  }
+  this->gc_cond_.notify_all();
+  if (this->gc_thread_.joinable()) {
+    this->gc_thread_.join();
+  }
+  if (this->owns_log_db_) {
+    LogDb log_db;
+    log_db.db = this->log_db_;
+    log_db.entry_cf = this->entry_cf_;
+    log_db.meta_cf = this->meta_cf_;
+    CloseLogDb(&log_db);
+  }
+}
+
+std::string RocksDBSingleLogStorageImpl::EntryKey(int64_t index) {
+  std::string key = this->key_prefix_;
+  key.append("I:");
+  EncodeDecodeTool::PutBigEndian64(&key, static_cast<uint64_t>(index));
+  return key;
+}
+
+std::string RocksDBSingleLogStorageImpl::MetaKey(const std::string& name) {
+  return this->key_prefix_ + "M:" + name;
+}
+
+EStatus RocksDBSingleLogStorageImpl::OpenLogDb(
+    const std::string& db_path,
+    const std::string& entry_cf_options,
+    LogDb*             log_db) {
+  std::vector<rocksdb::ColumnFamilyDescriptor> cfs;
+  cfs.emplace_back(rocksdb::kDefaultColumnFamilyName,
+                   rocksdb::ColumnFamilyOptions());
+  cfs.emplace_back(LOG_ENTRY_CF_NAME, EntryCfOptions(entry_cf_options));
+  cfs.emplace_back(LOG_META_CF_NAME, MetaCfOptions());
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  auto                                      st = rocksdb::DB::Open(
+      LogDbOptions(), db_path, cfs, &handles, &log_db->db);
+  if (!st.ok()) {
+    SPDLOG_ERROR("open log db {} failed {}", db_path, st.ToString());
+    return EStatus::kError;
+  }
+  // the db keeps its own handle of the default column family, which only
+  // the migration reads
+  log_db->db->DestroyColumnFamilyHandle(handles[0]);
+  log_db->entry_cf = handles[1];
+  log_db->meta_cf = handles[2];
+  return MigrateDefaultColumnFamily(log_db);
+}
+
+void RocksDBSingleLogStorageImpl::CloseLogDb(LogDb* log_db) {
+  if (log_db->db == nullptr) {
+    return;
+  }
+  log_db->db->DestroyColumnFamilyHandle(log_db->entry_cf);
+  log_db->db->DestroyColumnFamilyHandle(log_db->meta_cf);
+  delete log_db->db;
+  log_db->db = nullptr;
+  log_db->entry_cf = nullptr;
+  log_db->meta_cf = nullptr;
+}
+
+rocksdb::DBOptions RocksDBSingleLogStorageImpl::LogDbOptions() {
+  rocksdb::DBOptions options;
+  options.create_if_missing = true;
+  options.create_missing_column_families = true;
+  return options;
+}
+
+rocksdb::ColumnFamilyOptions RocksDBSingleLogStorageImpl::EntryCfOptions(
+    const std::string& entry_cf_options) {
+  rocksdb::ColumnFamilyOptions options;
+  // a few large memtables take the append batches, and universal compaction
+  // rewrites append only data far less than leveled compaction
+  options.write_buffer_size = LOG_ENTRY_CF_WRITE_BUFFER_SIZE;
+  options.max_write_buffer_number = LOG_ENTRY_CF_MAX_WRITE_BUFFERS;
+  options.compaction_style = rocksdb::kCompactionStyleUniversal;
+  // entries are only read at indexes known to be in the log, a bloom filter
+  // would never save a read
+  rocksdb::BlockBasedTableOptions table_options;
+  table_options.filter_policy.reset();
+  options.table_factory.reset(
+      rocksdb::NewBlockBasedTableFactory(table_options));
+  options.table_properties_collector_factories.emplace_back(
+      rocksdb::NewCompactOnDeletionCollectorFactory(
+          LOG_GC_DELETION_WINDOW, LOG_GC_DELETION_TRIGGER));
+  if (entry_cf_options.empty()) {
+    return options;
+  }
+  rocksdb::ColumnFamilyOptions tuned;
+  auto                         st = rocksdb::GetColumnFamilyOptionsFromString(
+      options, entry_cf_options, &tuned);
+  if (!st.ok()) {
+    SPDLOG_ERROR("bad log entry column family options {}, {}",
+                 entry_cf_options,
+                 st.ToString());
+    return options;
+  }
+  return tuned;
+}
+
+rocksdb::ColumnFamilyOptions RocksDBSingleLogStorageImpl::MetaCfOptions() {
+  rocksdb::ColumnFamilyOptions options;
+  options.write_buffer_size = LOG_META_CF_WRITE_BUFFER_SIZE;
+  return options;
+}
+
+EStatus RocksDBSingleLogStorageImpl::MigrateDefaultColumnFamily(
+    LogDb* log_db) {
+  rocksdb::ColumnFamilyHandle* default_cf = log_db->db->DefaultColumnFamily();
+  rocksdb::WriteOptions        write_options;
+  write_options.sync = true;
+  rocksdb::WriteBatch batch;
+  int64_t             chunk = 0;
+  int64_t             moved = 0;
+  rocksdb::Status     st;
+  auto iter = log_db->db->NewIterator(rocksdb::ReadOptions(), default_cf);
+  for (iter->SeekToFirst(); iter->Valid() && st.ok(); iter->Next()) {
+    // keys are [G<group id>/]E:<index> or [G<group id>/]M:<name>
+    std::string key = iter->key().ToString();
+    size_t      pos = 0;
+    if (!key.empty() && key[0] == 'G' && key.find('/') != std::string::npos) {
+      pos = key.find('/') + 1;
+    }
+    bool is_meta = key.compare(pos, 2, "M:") == 0;
+    batch.Put(
+        is_meta ? log_db->meta_cf : log_db->entry_cf, key, iter->value());
+    batch.Delete(default_cf, key);
+    chunk++;
+    if (chunk == LOG_DB_MIGRATE_BATCH) {
+      st = log_db->db->Write(write_options, &batch);
+      moved += chunk;
+      chunk = 0;
+      batch.Clear();
+    }
+  }
+  delete iter;
+  if (st.ok() && chunk > 0) {
+    st = log_db->db->Write(write_options, &batch);
+    moved += chunk;
+  }
+  if (!st.ok()) {
+    SPDLOG_ERROR("move legacy log keys failed {}", st.ToString());
+    return EStatus::kError;
+  }
+  if (moved > 0) {
+    SPDLOG_INFO("moved {} log keys out of the default column family", moved);
+    // drop the tombstones so later opens find the family empty at once
+    log_db->db->CompactRange(
+        rocksdb::CompactRangeOptions(), default_cf, nullptr, nullptr);
+  }
+  return EStatus::kOk;
+}
+
+EStatus RocksDBSingleLogStorageImpl::MigrateEntryKeys() {
+  std::string format_key = this->MetaKey("KEY_FORMAT");
+  std::string format;
+  auto        st = log_db_->Get(
+      rocksdb::ReadOptions(), this->meta_cf_, format_key, &format);
+  if (st.ok()) {
+    if (format == std::to_string(LOG_KEY_FORMAT_VERSION)) {
+      return EStatus::kOk;
+    }
+    SPDLOG_ERROR("log key format {} is not supported", format);
+    return EStatus::kError;
+  }
+  if (!st.IsNotFound()) {
+    SPDLOG_ERROR("read log key format failed {}", st.ToString());
+    return EStatus::kError;
+  }
+  // format 1 keys are "E:" + host endian index and sort out of index order.
+  // format 2 keys use another tag, so a key is never read in the wrong
+  // format wherever an interrupted migration stopped
+  std::string          legacy_prefix = this->key_prefix_ + "E:";
+  std::string          legacy_end = this->key_prefix_ + "E;";
+  rocksdb::Slice       upper_bound(legacy_end);
+  rocksdb::ReadOptions read_options;
+  read_options.iterate_upper_bound = &upper_bound;
+  rocksdb::WriteOptions write_options;
+  write_options.sync = true;
+  rocksdb::WriteBatch batch;
+  int64_t             chunk = 0;
+  int64_t             moved = 0;
+  st = rocksdb::Status::OK();
+  auto iter = log_db_->NewIterator(read_options, this->entry_cf_);
+  for (iter->Seek(legacy_prefix); iter->Valid() && st.ok(); iter->Next()) {
+    if (iter->key().size() != legacy_prefix.size() + 8) {
+      continue;
+    }
+    uint64_t index = EncodeDecodeTool::DecodeFixed64(
+        reinterpret_cast<const uint8_t*>(iter->key().data()) +
+        legacy_prefix.size());
+    batch.Put(this->entry_cf_, this->EntryKey(index), iter->value());
+    batch.Delete(this->entry_cf_, iter->key());
+    chunk++;
+    if (chunk == LOG_DB_MIGRATE_BATCH) {
+      st = log_db_->Write(write_options, &batch);
+      moved += chunk;
+      chunk = 0;
+      batch.Clear();
+    }
+  }
+  delete iter;
+  if (st.ok()) {
+    // the format is recorded with the last chunk
+    batch.Put(this->meta_cf_,
+              format_key,
+              std::to_string(LOG_KEY_FORMAT_VERSION));
+    st = log_db_->Write(write_options, &batch);
+    moved += chunk;
+  }
+  if (!st.ok()) {
+    SPDLOG_ERROR("rewrite log entry keys failed {}", st.ToString());
+    return EStatus::kError;
+  }
+  if (moved > 0) {
+    SPDLOG_INFO("rewrote {} log entry keys to format {}",
+                moved,
+                LOG_KEY_FORMAT_VERSION);
+  }
+  return EStatus::kOk;
+}
+
+void RocksDBSingleLogStorageImpl::StartBackgroundGc() {
+  std::lock_guard<std::mutex> lock(this->gc_mutex_);
+  if (this->gc_running_) {
+    return;
+  }
+  this->gc_running_ = true;
+  this->gc_thread_ =
+      std::thread(&RocksDBSingleLogStorageImpl::RunBackgroundGc, this);
+}
+
+EStatus RocksDBSingleLogStorageImpl::DeleteEntries(int64_t start,
+                                                   int64_t end,
+                                                   bool    background) {
+  if (start >= end) {
+    return EStatus::kOk;
+  }
+  // the keys of [start, end) are contiguous, one range tombstone covers
+  // them however long the range is
+  rocksdb::WriteBatch* batch = new rocksdb::WriteBatch();
+  batch->DeleteRange(
+      this->entry_cf_, this->EntryKey(start), this->EntryKey(end));
+  if (background) {
+    std::lock_guard<std::mutex> lock(this->gc_mutex_);
+    if (this->gc_running_) {
+      this->gc_queue_.push_back(batch);
+      this->gc_cond_.notify_one();
+      return EStatus::kOk;
+    }
+  }
+  auto st = log_db_->Write(rocksdb::WriteOptions(), batch);
+  delete batch;
+  if (!st.ok()) {
+    SPDLOG_ERROR(
+        "delete log entries [{}, {}) failed {}", start, end, st.ToString());
+    return EStatus::kError;
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief the queue is drained before the thread exits, so no erased entry
+ * is left behind on a clean shutdown
+ *
+ */
+void RocksDBSingleLogStorageImpl::RunBackgroundGc() {
+  while (true) {
+    rocksdb::WriteBatch* batch;
+    {
+      std::unique_lock<std::mutex> lock(this->gc_mutex_);
+      this->gc_cond_.wait(lock, [this] {
+        return !this->gc_queue_.empty() || !this->gc_running_;
+      });
+      if (this->gc_queue_.empty()) {
+        return;
+      }
+      batch = this->gc_queue_.front();
+      this->gc_queue_.pop_front();
+    }
+    auto st = log_db_->Write(rocksdb::WriteOptions(), batch);
+    if (!st.ok()) {
+      SPDLOG_ERROR("background log gc failed {}", st.ToString());
+    }
+    delete batch;
+  }
+}
+
+void RocksDBSingleLogStorageImpl::CacheEntries(
+    const std::vector<eraftkv::Entry*>& etys) {
+  std::lock_guard<std::mutex> lock(this->cache_mutex_);
+  for (auto ety : etys) {
+    this->entry_cache_.Append(ety);
+  }
+  // bound the cache while a follower is down or lagging
+  this->entry_cache_.Compact(LOG_ENTRY_CACHE_MAX_MEM);
+}
+
+bool RocksDBSingleLogStorageImpl::GetCached(int64_t         index,
+                                            eraftkv::Entry* ety) {
+  std::lock_guard<std::mutex> lock(this->cache_mutex_);
+  return this->entry_cache_.Get(index, ety);
 }
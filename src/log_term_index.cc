@@ -0,0 +1,151 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file log_term_index.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "log_term_index.h"
+
+#include <algorithm>
+
+LogTermIndex::LogTermIndex() : last_index_(-1) {}
+
+LogTermIndex::~LogTermIndex() {}
+
+void LogTermIndex::Append(int64_t index, int64_t term) {
+  if (index <= this->last_index_ && this->Term(index) == term) {
+    return;
+  }
+  this->TruncateFrom(index);
+  if (this->runs_.empty() || this->runs_.back().term != term ||
+      this->last_index_ + 1 != index) {
+    this->runs_.push_back(TermRun{index, term});
+  }
+  this->last_index_ = index;
+}
+
+void LogTermIndex::TruncateFrom(int64_t index) {
+  while (!this->runs_.empty() && this->runs_.back().first_index >= index) {
+    this->runs_.pop_back();
+  }
+  if (this->runs_.empty()) {
+    this->last_index_ = -1;
+  } else if (this->last_index_ >= index) {
+    this->last_index_ = index - 1;
+  }
+}
+
+void LogTermIndex::CompactTo(int64_t index) {
+  if (this->runs_.empty()) {
+    return;
+  }
+  if (index > this->last_index_) {
+    this->Clear();
+    return;
+  }
+  size_t drop = 0;
+  while (drop + 1 < this->runs_.size() &&
+         this->runs_[drop + 1].first_index <= index) {
+    drop++;
+  }
+  this->runs_.erase(this->runs_.begin(), this->runs_.begin() + drop);
+  this->runs_[0].first_index = std::max(this->runs_[0].first_index, index);
+}
+
+void LogTermIndex::ResetFirst(int64_t index, int64_t term) {
+  if (this->runs_.empty() || index > this->last_index_ ||
+      index < this->runs_[0].first_index) {
+    this->runs_.clear();
+    this->runs_.push_back(TermRun{index, term});
+    this->last_index_ = index;
+    return;
+  }
+  this->CompactTo(index);
+  if (this->runs_[0].term == term) {
+    return;
+  }
+  // split the first entry off its run
+  int64_t run_end = this->runs_.size() > 1 ? this->runs_[1].first_index - 1
+                                           : this->last_index_;
+  if (run_end > index) {
+    this->runs_.insert(this->runs_.begin() + 1,
+                       TermRun{index + 1, this->runs_[0].term});
+  }
+  this->runs_[0].term = term;
+}
+
+void LogTermIndex::Clear() {
+  this->runs_.clear();
+  this->last_index_ = -1;
+}
+
+int64_t LogTermIndex::Term(int64_t index) {
+  if (this->runs_.empty() || index < this->runs_[0].first_index ||
+      index > this->last_index_) {
+    return -1;
+  }
+  auto it = std::upper_bound(
+      this->runs_.begin(),
+      this->runs_.end(),
+      index,
+      [](int64_t idx, const TermRun& run) { return idx < run.first_index; });
+  return (it - 1)->term;
+}
+
+int64_t LogTermIndex::FirstIndexOfTerm(int64_t term) {
+  for (auto& run : this->runs_) {
+    if (run.term == term) {
+      return run.first_index;
+    }
+  }
+  return -1;
+}
+
+int64_t LogTermIndex::LastIndexOfTerm(int64_t term) {
+  for (size_t i = this->runs_.size(); i > 0; i--) {
+    if (this->runs_[i - 1].term == term) {
+      return i == this->runs_.size() ? this->last_index_
+                                     : this->runs_[i].first_index - 1;
+    }
+  }
+  return -1;
+}
+
+int64_t LogTermIndex::FirstIndex() {
+  return this->runs_.empty() ? -1 : this->runs_[0].first_index;
+}
+
+int64_t LogTermIndex::LastIndex() {
+  return this->last_index_;
+}
+
+uint64_t LogTermIndex::RunCount() {
+  return this->runs_.size();
+}
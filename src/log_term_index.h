@@ -0,0 +1,163 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file log_term_index.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+/**
+ * @brief a run of consecutive log entries with the same term
+ *
+ */
+struct TermRun {
+  int64_t first_index;
+  int64_t term;
+};
+
+/**
+ * @brief in memory index of the term runs of a raft log, a log of n entries
+ * spread over k terms takes k runs
+ *
+ */
+class LogTermIndex {
+
+ public:
+  /**
+   * @brief Construct a new Log Term Index object
+   *
+   */
+  LogTermIndex();
+
+  /**
+   * @brief Destroy the Log Term Index object
+   *
+   */
+  ~LogTermIndex();
+
+  /**
+   * @brief record entry (index, term) as the last entry, entries with id >=
+   * index are dropped first unless the index already holds term, then the
+   * index is left as it is
+   *
+   * @param index
+   * @param term
+   */
+  void Append(int64_t index, int64_t term);
+
+  /**
+   * @brief drop all the entries with id >= index
+   *
+   * @param index
+   */
+  void TruncateFrom(int64_t index);
+
+  /**
+   * @brief drop all the entries with id < index
+   *
+   * @param index
+   */
+  void CompactTo(int64_t index);
+
+  /**
+   * @brief make (index, term) the first entry of the log
+   *
+   * @param index
+   * @param term
+   */
+  void ResetFirst(int64_t index, int64_t term);
+
+  /**
+   * @brief
+   *
+   */
+  void Clear();
+
+  /**
+   * @brief term of the entry with id = index, -1 if not indexed
+   *
+   * @param index
+   * @return int64_t
+   */
+  int64_t Term(int64_t index);
+
+  /**
+   * @brief first index of the given term, -1 if the log has no such entry
+   *
+   * @param term
+   * @return int64_t
+   */
+  int64_t FirstIndexOfTerm(int64_t term);
+
+  /**
+   * @brief last index of the given term, -1 if the log has no such entry
+   *
+   * @param term
+   * @return int64_t
+   */
+  int64_t LastIndexOfTerm(int64_t term);
+
+  /**
+   * @brief
+   *
+   * @return int64_t
+   */
+  int64_t FirstIndex();
+
+  /**
+   * @brief
+   *
+   * @return int64_t
+   */
+  int64_t LastIndex();
+
+  /**
+   * @brief
+   *
+   * @return uint64_t
+   */
+  uint64_t RunCount();
+
+ private:
+  /**
+   * @brief term runs ordered by first index
+   *
+   */
+  std::vector<TermRun> runs_;
+
+  /**
+   * @brief index of the last entry, runs_.back() ends here
+   *
+   */
+  int64_t last_index_;
+};
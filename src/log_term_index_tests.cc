@@ -0,0 +1,122 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file log_term_index_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "log_term_index.h"
+
+TEST(LogTermIndexTest, Init) {
+  LogTermIndex* term_index = new LogTermIndex();
+  ASSERT_EQ(0, term_index->RunCount());
+  ASSERT_EQ(-1, term_index->Term(0));
+  ASSERT_EQ(-1, term_index->LastIndexOfTerm(1));
+  delete term_index;
+}
+
+TEST(LogTermIndexTest, AppendRuns) {
+  LogTermIndex* term_index = new LogTermIndex();
+  term_index->Append(0, 0);
+  for (int64_t i = 1; i <= 10; i++) {
+    term_index->Append(i, i <= 5 ? 1 : 3);
+  }
+  ASSERT_EQ(3, term_index->RunCount());
+  ASSERT_EQ(0, term_index->Term(0));
+  ASSERT_EQ(1, term_index->Term(5));
+  ASSERT_EQ(3, term_index->Term(6));
+  ASSERT_EQ(-1, term_index->Term(11));
+  ASSERT_EQ(1, term_index->FirstIndexOfTerm(1));
+  ASSERT_EQ(5, term_index->LastIndexOfTerm(1));
+  ASSERT_EQ(6, term_index->FirstIndexOfTerm(3));
+  ASSERT_EQ(10, term_index->LastIndexOfTerm(3));
+  ASSERT_EQ(-1, term_index->FirstIndexOfTerm(2));
+  delete term_index;
+}
+
+TEST(LogTermIndexTest, OverwriteTail) {
+  LogTermIndex* term_index = new LogTermIndex();
+  for (int64_t i = 1; i <= 10; i++) {
+    term_index->Append(i, i <= 5 ? 1 : 2);
+  }
+  // a new leader overwrites the entries from index 4
+  term_index->Append(4, 3);
+  ASSERT_EQ(4, term_index->LastIndex());
+  ASSERT_EQ(2, term_index->RunCount());
+  ASSERT_EQ(3, term_index->LastIndexOfTerm(1));
+  ASSERT_EQ(-1, term_index->LastIndexOfTerm(2));
+  ASSERT_EQ(3, term_index->Term(4));
+  term_index->TruncateFrom(2);
+  ASSERT_EQ(1, term_index->LastIndex());
+  ASSERT_EQ(1, term_index->Term(1));
+  delete term_index;
+}
+
+TEST(LogTermIndexTest, AppendMatchingKeepsTail) {
+  LogTermIndex* term_index = new LogTermIndex();
+  for (int64_t i = 1; i <= 10; i++) {
+    term_index->Append(i, i <= 5 ? 1 : 2);
+  }
+  // a resent entry with the same term leaves the entries after it
+  term_index->Append(3, 1);
+  term_index->Append(7, 2);
+  ASSERT_EQ(10, term_index->LastIndex());
+  ASSERT_EQ(2, term_index->RunCount());
+  ASSERT_EQ(2, term_index->Term(10));
+  // a conflicting term still truncates
+  term_index->Append(7, 3);
+  ASSERT_EQ(7, term_index->LastIndex());
+  ASSERT_EQ(3, term_index->Term(7));
+  delete term_index;
+}
+
+TEST(LogTermIndexTest, CompactAndResetFirst) {
+  LogTermIndex* term_index = new LogTermIndex();
+  for (int64_t i = 1; i <= 10; i++) {
+    term_index->Append(i, i <= 5 ? 1 : 2);
+  }
+  term_index->CompactTo(7);
+  ASSERT_EQ(1, term_index->RunCount());
+  ASSERT_EQ(7, term_index->FirstIndex());
+  ASSERT_EQ(-1, term_index->Term(6));
+  ASSERT_EQ(2, term_index->Term(7));
+  // snapshot entry written with another term keeps the rest of the run
+  term_index->ResetFirst(8, 4);
+  ASSERT_EQ(8, term_index->FirstIndex());
+  ASSERT_EQ(4, term_index->Term(8));
+  ASSERT_EQ(2, term_index->Term(9));
+  ASSERT_EQ(10, term_index->LastIndex());
+  // snapshot beyond the log replaces it
+  term_index->ResetFirst(20, 5);
+  ASSERT_EQ(1, term_index->RunCount());
+  ASSERT_EQ(20, term_index->LastIndex());
+  ASSERT_EQ(5, term_index->Term(20));
+  delete term_index;
+}
@@ -88,6 +88,21 @@ class Network {
                            RaftNode*          raft_node,
                            const std::string& filename) = 0;
 
+  /**
+   * @brief ask the leader for a confirmed read index, blocks until the
+   * leader answers
+   *
+   * @param raft
+   * @param target_node
+   * @param req
+   * @param resp
+   * @return EStatus
+   */
+  virtual EStatus SendReadIndex(RaftServer*             raft,
+                                RaftNode*               target_node,
+                                eraftkv::ReadIndexReq*  req,
+                                eraftkv::ReadIndexResp* resp) = 0;
+
   /**
    * @brief
    *
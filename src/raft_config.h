@@ -37,10 +37,21 @@
 #include <string>
 #include <vector>
 
+#include "consts.h"
 #include "network.h"
 #include "raft_log.h"
 #include "raft_node.h"
 #include "storage.h"
+
+class TimerWheel;
+/**
+ * @brief how the leader confirms it is still leader before serving a read.
+ * ReadOnlySafe confirms with a heartbeat quorum per read batch (read index),
+ * ReadOnlyLeaseBased serves locally while the leader lease is valid
+ *
+ */
+enum ReadModeEnum { ReadOnlySafe, ReadOnlyLeaseBased };
+
 /**
  * @brief
  *
@@ -56,4 +67,20 @@ struct RaftConfig {
   Network*                       net_impl;
   Storage*                       store_impl;
   LogStore*                      log_impl;
+  ReadModeEnum                   read_mode = ReadModeEnum::ReadOnlySafe;
+  int64_t                        clock_drift_bound_ms = 0;
+  int64_t                        max_entries_per_append =
+      MAX_ENTRIES_PER_APPEND_REQ;
+  int64_t                        max_bytes_per_append =
+      MAX_BYTES_PER_APPEND_REQ;
+  int64_t                        group_id = DEFAULT_RAFT_GROUP_ID;
+  // a timer wheel shared by the raft groups of one process, the server
+  // creates its own if null
+  TimerWheel*                    timer_wheel = nullptr;
+  // false if net_impl is shared with other raft groups
+  bool                           owns_net = true;
+  // codec of the normal entry payloads this node proposes as leader
+  eraftkv::CompressType          log_compress = eraftkv::NoCompress;
+  // threads applying the committed normal entries of one group to its kv db
+  int64_t                        apply_workers = 1;
 };
@@ -0,0 +1,272 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file raft_group_host.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "raft_group_host.h"
+
+#include <spdlog/spdlog.h>
+
+#include "consts.h"
+#include "util.h"
+
+/**
+ * @brief Construct a new Raft Group Host object, open the shared log db and
+ * connect the shared transport to the peers
+ *
+ * @param base_config
+ * @param log_db_path
+ * @param apply_threads
+ * @param entry_cf_options
+ * @param log_gc_async
+ */
+RaftGroupHost::RaftGroupHost(RaftConfig  base_config,
+                             std::string log_db_path,
+                             int64_t     apply_threads,
+                             std::string entry_cf_options,
+                             bool        log_gc_async)
+    : base_config_(base_config)
+    , timer_wheel_(TIMER_WHEEL_TICK_MS, TIMER_WHEEL_SLOTS)
+    , net_(new GRpcNetworkImpl())
+    , apply_thread_count_(apply_threads)
+    , log_gc_async_(log_gc_async)
+    , running_(false) {
+  auto st = RocksDBSingleLogStorageImpl::OpenLogDb(
+      log_db_path, entry_cf_options, &this->log_db_);
+  assert(st == EStatus::kOk);
+  this->net_->InitPeerNodeConnections(base_config_.peer_address_map);
+}
+
+RaftGroupHost::~RaftGroupHost() {
+  this->running_ = false;
+  this->apply_cond_.notify_all();
+  if (this->cycle_thread_.joinable()) {
+    this->cycle_thread_.join();
+  }
+  for (auto& th : this->apply_threads_) {
+    th.join();
+  }
+  // the shared transport is drained while the groups its resp handlers call
+  // back into are still alive
+  delete this->net_;
+  for (auto group : this->groups_) {
+    delete group.second;
+  }
+  RocksDBSingleLogStorageImpl::CloseLogDb(&this->log_db_);
+}
+
+/**
+ * @brief create a raft group on the shared wheel, log db and transport,
+ * the group keeps its own kv db and snapshot db
+ *
+ * @param group_id
+ * @param start_slot
+ * @param end_slot
+ * @param kv_db_path
+ * @return EStatus
+ */
+EStatus RaftGroupHost::AddGroup(int64_t     group_id,
+                                int64_t     start_slot,
+                                int64_t     end_slot,
+                                std::string kv_db_path) {
+  std::lock_guard<std::mutex> lock(this->groups_mutex_);
+  if (this->groups_.count(group_id) != 0) {
+    SPDLOG_ERROR("raft group {} already exists", group_id);
+    return EStatus::kError;
+  }
+  RaftConfig config = this->base_config_;
+  config.group_id = group_id;
+  config.timer_wheel = &this->timer_wheel_;
+  config.owns_net = false;
+  config.snap_path =
+      this->base_config_.snap_path + "_g" + std::to_string(group_id);
+  // the trailing separator keeps a group prefix from being a prefix of
+  // another group's
+  auto log_store = new RocksDBSingleLogStorageImpl(
+      this->log_db_, "G" + std::to_string(group_id) + "/");
+  if (this->log_gc_async_) {
+    // the queued deletes are written before the group is destroyed, ahead
+    // of the shared log db close
+    log_store->StartBackgroundGc();
+  }
+  auto kv_store = new RocksDBStorageImpl(kv_db_path, config.apply_workers);
+  auto raft = new RaftServer(config, log_store, kv_store, this->net_);
+  raft->SetApplyNotifier([this, group_id] { this->ScheduleApply(group_id); });
+  this->groups_[group_id] = raft;
+  for (int64_t slot = start_slot; slot <= end_slot; slot++) {
+    this->slot_groups_[slot] = group_id;
+  }
+  SPDLOG_INFO("add raft group {} with slots [{}, {}]",
+              group_id,
+              start_slot,
+              end_slot);
+  return EStatus::kOk;
+}
+
+/**
+ * @brief
+ *
+ * @return EStatus
+ */
+EStatus RaftGroupHost::Start() {
+  if (this->running_.exchange(true)) {
+    return EStatus::kOk;
+  }
+  this->cycle_thread_ = std::thread(&RaftGroupHost::RunCycle, this);
+  for (int64_t i = 0; i < this->apply_thread_count_; i++) {
+    this->apply_threads_.emplace_back(&RaftGroupHost::RunApply, this);
+  }
+  return EStatus::kOk;
+}
+
+RaftServer* RaftGroupHost::GetGroup(int64_t group_id) {
+  std::lock_guard<std::mutex> lock(this->groups_mutex_);
+  auto                        it = this->groups_.find(group_id);
+  return it == this->groups_.end() ? nullptr : it->second;
+}
+
+RaftServer* RaftGroupHost::GetGroupByKey(const std::string& key) {
+  std::lock_guard<std::mutex> lock(this->groups_mutex_);
+  auto slot_it = this->slot_groups_.find(KeySlot(key));
+  if (slot_it == this->slot_groups_.end()) {
+    return nullptr;
+  }
+  auto it = this->groups_.find(slot_it->second);
+  return it == this->groups_.end() ? nullptr : it->second;
+}
+
+std::vector<RaftServer*> RaftGroupHost::GetGroupsByKeys(
+    const std::vector<std::string>& keys) {
+  std::vector<uint64_t> crcs;
+  HashUtil::CRC64Batch(keys, &crcs);
+  std::vector<RaftServer*>    groups(keys.size(), nullptr);
+  std::lock_guard<std::mutex> lock(this->groups_mutex_);
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto slot_it = this->slot_groups_.find(crcs[i] % KEY_SLOT_COUNT);
+    if (slot_it == this->slot_groups_.end()) {
+      continue;
+    }
+    auto it = this->groups_.find(slot_it->second);
+    if (it != this->groups_.end()) {
+      groups[i] = it->second;
+    }
+  }
+  return groups;
+}
+
+std::vector<RaftServer*> RaftGroupHost::GetGroups() {
+  std::lock_guard<std::mutex> lock(this->groups_mutex_);
+  std::vector<RaftServer*>    groups;
+  for (auto group : this->groups_) {
+    groups.push_back(group.second);
+  }
+  return groups;
+}
+
+/**
+ * @brief same slot function the client routes keys with
+ *
+ * @param key
+ * @return int64_t
+ */
+int64_t RaftGroupHost::KeySlot(const std::string& key) {
+  return HashUtil::CRC64(0, key.c_str(), key.size()) % KEY_SLOT_COUNT;
+}
+
+/**
+ * @brief a single thread runs the heartbeat and election timers of every
+ * group, so the thread count does not grow with the group count
+ *
+ */
+void RaftGroupHost::RunCycle() {
+  while (this->running_) {
+    this->timer_wheel_.WaitForExpire(APPLY_WAIT_TIMEOUT_MS);
+    this->timer_wheel_.RunExpired();
+  }
+}
+
+/**
+ * @brief take groups off the apply queue, a group is applied by at most one
+ * worker at a time so its entries stay in log order. when the queue stays
+ * empty for a wait timeout the groups with unapplied committed entries are
+ * queued, this resumes groups whose auto apply was paused without a commit
+ * notification
+ *
+ */
+void RaftGroupHost::RunApply() {
+  while (this->running_) {
+    int64_t group_id;
+    {
+      std::unique_lock<std::mutex> lock(this->apply_mutex_);
+      this->apply_cond_.wait_for(
+          lock, std::chrono::milliseconds(APPLY_WAIT_TIMEOUT_MS), [this] {
+            return !this->apply_queue_.empty() || !this->running_;
+          });
+      if (this->apply_queue_.empty()) {
+        lock.unlock();
+        for (auto raft : this->GetGroups()) {
+          if (raft->HasUnappliedEntries()) {
+            this->ScheduleApply(raft->GetGroupId());
+          }
+        }
+        continue;
+      }
+      group_id = this->apply_queue_.front();
+      this->apply_queue_.pop_front();
+      this->apply_queued_.erase(group_id);
+      this->apply_running_.insert(group_id);
+    }
+    RaftServer* raft = this->GetGroup(group_id);
+    if (raft != nullptr) {
+      raft->ApplyCommitted();
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->apply_mutex_);
+      this->apply_running_.erase(group_id);
+      if (this->apply_dirty_.erase(group_id) != 0) {
+        this->apply_queue_.push_back(group_id);
+        this->apply_queued_.insert(group_id);
+        this->apply_cond_.notify_one();
+      }
+    }
+  }
+}
+
+void RaftGroupHost::ScheduleApply(int64_t group_id) {
+  std::lock_guard<std::mutex> lock(this->apply_mutex_);
+  if (this->apply_running_.count(group_id) != 0) {
+    this->apply_dirty_.insert(group_id);
+    return;
+  }
+  if (this->apply_queued_.insert(group_id).second) {
+    this->apply_queue_.push_back(group_id);
+    this->apply_cond_.notify_one();
+  }
+}
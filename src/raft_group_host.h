@@ -0,0 +1,208 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file raft_group_host.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "estatus.h"
+#include "grpc_network_impl.h"
+#include "raft_config.h"
+#include "raft_server.h"
+#include "rocksdb_storage_impl.h"
+#include "timer_wheel.h"
+
+/**
+ * @brief hosts several raft groups in one process, the groups share one
+ * timer wheel driven by a single core thread, a fixed apply thread pool,
+ * one log rocksdb and one grpc transport. raft rpcs are routed to a group
+ * by the group id in the rpc metadata, client keys by their key slot
+ *
+ */
+class RaftGroupHost {
+
+ public:
+  /**
+   * @brief Construct a new Raft Group Host object
+   *
+   * @param base_config config shared by all the groups
+   * @param log_db_path path of the shared log db
+   * @param apply_threads size of the apply thread pool
+   * @param entry_cf_options rocksdb options string tuning the log entry
+   * column family
+   * @param log_gc_async delete the compacted entries of every group on a
+   * background thread
+   */
+  RaftGroupHost(RaftConfig  base_config,
+                std::string log_db_path,
+                int64_t     apply_threads,
+                std::string entry_cf_options = "",
+                bool        log_gc_async = false);
+
+  /**
+   * @brief stop the host threads and destroy all the groups
+   *
+   */
+  ~RaftGroupHost();
+
+  /**
+   * @brief create a raft group serving the key slots in
+   * [start_slot, end_slot]
+   *
+   * @param group_id
+   * @param start_slot
+   * @param end_slot
+   * @param kv_db_path
+   * @return EStatus
+   */
+  EStatus AddGroup(int64_t     group_id,
+                   int64_t     start_slot,
+                   int64_t     end_slot,
+                   std::string kv_db_path);
+
+  /**
+   * @brief start the core thread and the apply thread pool
+   *
+   * @return EStatus
+   */
+  EStatus Start();
+
+  /**
+   * @brief Get the raft group with group_id
+   *
+   * @param group_id
+   * @return RaftServer* nullptr if the group is not hosted here
+   */
+  RaftServer* GetGroup(int64_t group_id);
+
+  /**
+   * @brief Get the raft group serving the slot of key
+   *
+   * @param key
+   * @return RaftServer* nullptr if no group serves the slot
+   */
+  RaftServer* GetGroupByKey(const std::string& key);
+
+  /**
+   * @brief Get the raft groups serving the slots of keys, the keys are hashed
+   * in one batch
+   *
+   * @param keys
+   * @return std::vector<RaftServer*> the i-th group serves keys[i], nullptr
+   * if no group serves its slot
+   */
+  std::vector<RaftServer*> GetGroupsByKeys(
+      const std::vector<std::string>& keys);
+
+  /**
+   * @brief Get all the hosted raft groups
+   *
+   * @return std::vector<RaftServer*>
+   */
+  std::vector<RaftServer*> GetGroups();
+
+  /**
+   * @brief the key slot of key
+   *
+   * @param key
+   * @return int64_t
+   */
+  static int64_t KeySlot(const std::string& key);
+
+ private:
+  /**
+   * @brief run the expired timers of all the groups
+   *
+   */
+  void RunCycle();
+
+  /**
+   * @brief apply worker, applies the committed entries of one group at a
+   * time
+   *
+   */
+  void RunApply();
+
+  /**
+   * @brief queue group_id for apply, a group already being applied is
+   * marked dirty and queued again once its worker finishes
+   *
+   * @param group_id
+   */
+  void ScheduleApply(int64_t group_id);
+
+  RaftConfig base_config_;
+
+  TimerWheel timer_wheel_;
+
+  GRpcNetworkImpl* net_;
+
+  LogDb log_db_;
+
+  std::map<int64_t, RaftServer*> groups_;
+
+  std::map<int64_t, int64_t> slot_groups_;
+
+  std::mutex groups_mutex_;
+
+  std::deque<int64_t> apply_queue_;
+
+  std::set<int64_t> apply_queued_;
+
+  std::set<int64_t> apply_running_;
+
+  std::set<int64_t> apply_dirty_;
+
+  std::mutex apply_mutex_;
+
+  std::condition_variable apply_cond_;
+
+  int64_t apply_thread_count_;
+
+  bool log_gc_async_;
+
+  std::atomic<bool> running_;
+
+  std::thread cycle_thread_;
+
+  std::vector<std::thread> apply_threads_;
+};
@@ -60,6 +60,27 @@ class LogStore {
    */
   virtual EStatus Append(eraftkv::Entry* ety) = 0;
 
+  /**
+   * @brief AppendBatch add a batch of new entries with one durable write
+   *
+   * @param etys
+   * @return EStatus
+   */
+  virtual EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys) = 0;
+
+  /**
+   * @brief AppendBatch add a batch of new entries and persist the log meta
+   * state in the same durable write
+   *
+   * @param etys
+   * @param commit_idx
+   * @param applied_idx
+   * @return EStatus
+   */
+  virtual EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys,
+                              int64_t                             commit_idx,
+                              int64_t applied_idx) = 0;
+
   /**
    * @brief EraseBefore erase all entries before the given index
    *
@@ -77,22 +98,26 @@ class LogStore {
   virtual EStatus EraseAfter(int64_t from_index) = 0;
 
   /**
-   * @brief Get get the given index entry
+   * @brief Get read the given index entry into the caller owned ety
    *
    * @param index
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus kNotFound if the entry is not in the log, ety is cleared
    */
-  virtual eraftkv::Entry* Get(int64_t index) = 0;
+  virtual EStatus Get(int64_t index, eraftkv::Entry* ety) = 0;
 
   /**
-   * @brief Gets get the given index range entry
+   * @brief Gets read the entries in [start_index, end_index] into entries,
+   * the entry objects already in entries are reused
    *
    * @param start_index
    * @param end_index
-   * @return std::vector<eraftkv::Entry*>
+   * @param entries
+   * @return EStatus kNotFound if the range is cut short by a missing entry
    */
-  virtual std::vector<eraftkv::Entry*> Gets(int64_t start_index,
-                                            int64_t end_index) = 0;
+  virtual EStatus Gets(int64_t                      start_index,
+                       int64_t                      end_index,
+                       std::vector<eraftkv::Entry>* entries) = 0;
 
   /**
    * @brief FirstIndex get the first index in the entry
@@ -135,16 +160,58 @@ class LogStore {
   /**
    * @brief Get the First Ety object
    *
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus
    */
-  virtual eraftkv::Entry* GetFirstEty() = 0;
+  virtual EStatus GetFirstEty(eraftkv::Entry* ety) = 0;
 
   /**
    * @brief Get the Last Ety object
    *
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus
+   */
+  virtual EStatus GetLastEty(eraftkv::Entry* ety) = 0;
+
+  /**
+   * @brief Term get the term of the given index entry without reading the
+   * entry
+   *
+   * @param index
+   * @return int64_t
+   */
+  virtual int64_t Term(int64_t index) = 0;
+
+  /**
+   * @brief LastTerm get the term of the last entry
+   *
+   * @return int64_t
+   */
+  virtual int64_t LastTerm() = 0;
+
+  /**
+   * @brief FirstIndexOfTerm get the first index of the given term
+   *
+   * @param term
+   * @return int64_t -1 if the log has no entry of the term
+   */
+  virtual int64_t FirstIndexOfTerm(int64_t term) = 0;
+
+  /**
+   * @brief LastIndexOfTerm get the last index of the given term
+   *
+   * @param term
+   * @return int64_t -1 if the log has no entry of the term
+   */
+  virtual int64_t LastIndexOfTerm(int64_t term) = 0;
+
+  /**
+   * @brief ReleaseCache the entries with id < index are applied and
+   * replicated to all the followers, in memory copies of them can be dropped
+   *
+   * @param index
    */
-  virtual eraftkv::Entry* GetLastEty() = 0;
+  virtual void ReleaseCache(int64_t index) = 0;
 
   virtual EStatus PersisLogMetaState(int64_t commit_idx,
                                      int64_t applied_idx) = 0;
@@ -42,16 +42,29 @@
  */
 enum NodeStateEnum { Init, Voting, Running, Down, LostConnection };
 
+/**
+ * @brief replication progress of a follower seen from the leader.
+ * Probe sends one append entries request at a time until the match point is
+ * found, Replicate pipelines requests up to the in flight window, Snapshot
+ * pauses appends while a snapshot is being sent
+ *
+ */
+enum ProgressStateEnum { Probe, Replicate, Snapshot };
+
 /**
  * @brief
  *
  */
 struct RaftNode {
-  int64_t       id;
-  NodeStateEnum node_state;
-  int64_t       next_log_index;
-  int64_t       match_log_index;
-  std::string   address;
+  int64_t           id;
+  NodeStateEnum     node_state;
+  int64_t           next_log_index;
+  int64_t           match_log_index;
+  std::string       address;
+  int64_t           inflight_append_reqs;
+  int64_t           acked_message_index;
+  int64_t           heartbeat_ack_time_ms;
+  ProgressStateEnum progress_state;
 
   RaftNode(int64_t       id_,
            NodeStateEnum node_state_,
@@ -62,5 +75,9 @@ struct RaftNode {
       , node_state(node_state_)
       , next_log_index(next_log_index_)
       , match_log_index(match_log_index_)
-      , address(address_) {}
+      , address(address_)
+      , inflight_append_reqs(0)
+      , acked_message_index(0)
+      , heartbeat_ack_time_ms(0)
+      , progress_state(ProgressStateEnum::Probe) {}
 };
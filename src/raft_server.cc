@@ -40,6 +40,7 @@
 #include <iostream>
 #include <thread>
 
+#include "compress_util.h"
 #include "consts.h"
 #include "rocksdb_storage_impl.h"
 #include "util.h"
@@ -59,26 +60,52 @@ RaftServer::RaftServer(RaftConfig raft_config,
     , voted_for_(-1)
     , commit_idx_(0)
     , last_applied_idx_(0)
-    , tick_count_(0)
     , leader_id_(-1)
     , heartbeat_timeout_(2)
     , election_timeout_(0)
     , base_election_timeout_(10)
-    , heartbeat_tick_count_(0)
-    , election_tick_count_(0)
-    , max_entries_per_append_req_(100)
+    , max_entries_per_append_req_(raft_config.max_entries_per_append)
+    , max_bytes_per_append_req_(raft_config.max_bytes_per_append)
+    , max_inflight_append_reqs_(MAX_INFLIGHT_APPEND_REQS_PER_NODE)
+    , propose_queue_bytes_(0)
+    , propose_batch_running_(false)
+    , propose_batch_window_us_(PROPOSE_BATCH_WINDOW_US)
+    , propose_batch_max_bytes_(PROPOSE_BATCH_MAX_BYTES)
+    , log_compress_(raft_config.log_compress)
+    , committed_queue_(COMMITTED_ENTRY_QUEUE_SIZE)
+    , message_index_(0)
+    , last_acked_message_index_(0)
+    , read_index_round_inflight_(false)
+    , read_mode_(raft_config.read_mode)
+    , clock_drift_bound_ms_(raft_config.clock_drift_bound_ms)
+    , last_leader_contact_ms_(0)
     , tick_interval_(100)
     , granted_votes_(0)
     , snap_threshold_log_count_(10000)
     , open_auto_apply_(true)
     , is_snapshoting_(false)
+    , snapshot_running_(false)
     , snap_db_path_(raft_config.snap_path)
-    , election_running_(true) {
+    , election_running_(true)
+    , group_id_(raft_config.group_id)
+    , owns_net_(raft_config.owns_net)
+    , timer_wheel_(raft_config.timer_wheel)
+    , owns_timer_wheel_(raft_config.timer_wheel == nullptr) {
+  if (this->owns_timer_wheel_) {
+    this->timer_wheel_ = new TimerWheel(TIMER_WHEEL_TICK_MS, TIMER_WHEEL_SLOTS);
+  }
   this->log_store_ = log_store;
   this->store_ = store;
   this->net_ = net;
   this->store_->ReadRaftMeta(this, &this->current_term_, &this->voted_for_);
   this->log_store_->ReadMetaState(&this->commit_idx_, &this->last_applied_idx_);
+  // the kv db writes its applied index atomically with the applied data, an
+  // index below the first log entry predates an installed snapshot
+  int64_t kv_applied_idx;
+  if (this->store_->ReadAppliedIdx(&kv_applied_idx) == EStatus::kOk &&
+      kv_applied_idx >= this->log_store_->FirstIndex()) {
+    this->last_applied_idx_ = kv_applied_idx;
+  }
   SPDLOG_INFO(
       " raft server init with current_term {}  voted_for {}  commit_idx {}",
       current_term_,
@@ -92,11 +119,32 @@ RaftServer::RaftServer(RaftConfig raft_config,
                                   n.second);
     this->nodes_.push_back(node);
   }
+  this->election_timer_id_ =
+      this->timer_wheel_->AddTimer(0, [this] { this->ElectionTimeout(); });
+  this->heartbeat_timer_id_ =
+      this->timer_wheel_->AddTimer(0, [this] { this->HeartbeatTimeout(); });
+  ResetRandomElectionTimeout();
 }
 
 RaftServer::~RaftServer() {
+  {
+    std::lock_guard<std::mutex> lock(this->snapshot_mutex_);
+    this->snapshot_running_ = false;
+  }
+  this->snapshot_cond_.notify_all();
+  if (this->snapshot_thread_.joinable()) {
+    this->snapshot_thread_.join();
+  }
+  this->timer_wheel_->CancelTimer(this->election_timer_id_);
+  this->timer_wheel_->CancelTimer(this->heartbeat_timer_id_);
+  if (this->owns_timer_wheel_) {
+    delete this->timer_wheel_;
+  }
+  // drain the in flight rpcs first, their resp handlers touch the log store
+  if (this->owns_net_) {
+    delete this->net_;
+  }
   delete this->log_store_;
-  delete this->net_;
   delete this->store_;
 }
 
@@ -105,7 +153,8 @@ EStatus RaftServer::ResetRandomElectionTimeout() {
   auto rand_tick =
       RandomNumber::Between(base_election_timeout_, 2 * base_election_timeout_);
   election_timeout_ = rand_tick;
-  election_tick_count_ = 0;
+  this->timer_wheel_->ResetTimer(this->election_timer_id_,
+                                election_timeout_ * tick_interval_);
   return EStatus::kOk;
 }
 
@@ -122,62 +171,134 @@ RaftServer* RaftServer::RunMainLoop(RaftConfig raft_config,
 }
 
 
+/**
+ * @brief apply committed entries as soon as the commit index advances, the
+ * wait timeout only bounds how long a paused auto apply takes to resume
+ *
+ */
 void RaftServer::RunApply() {
   while (true) {
-    if (open_auto_apply_) {
-      this->ApplyEntries();
+    {
+      std::unique_lock<std::mutex> lock(this->apply_mutex_);
+      this->apply_cond_.wait_for(
+          lock, std::chrono::milliseconds(APPLY_WAIT_TIMEOUT_MS), [this] {
+            return this->commit_idx_ > this->last_applied_idx_;
+          });
     }
-    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    this->ApplyCommitted();
   }
 }
 
 /**
- * @brief raft core cycle
+ * @brief
+ *
+ */
+void RaftServer::ApplyCommitted() {
+  if (open_auto_apply_) {
+    this->ApplyEntries();
+  }
+}
+
+/**
+ * @brief
+ *
+ * @param notifier
+ */
+void RaftServer::SetApplyNotifier(std::function<void()> notifier) {
+  std::lock_guard<std::mutex> lock(this->apply_mutex_);
+  this->apply_notifier_ = notifier;
+}
+
+/**
+ * @brief
+ *
+ * @return int64_t
+ */
+int64_t RaftServer::GetGroupId() {
+  return this->group_id_;
+}
+
+/**
+ * @brief the raft groups of one process share the data dir, each one sends
+ * and receives its sst files in its own dir
+ *
+ * @return std::string
+ */
+std::string RaftServer::SnapshotSendDir() {
+  return std::string(SNAPSHOT_SEND_DIR) + "g" +
+         std::to_string(this->group_id_) + "/";
+}
+
+std::string RaftServer::SnapshotRecvDir() {
+  return std::string(SNAPSHOT_RECV_DIR) + "g" +
+         std::to_string(this->group_id_) + "/";
+}
+
+bool RaftServer::HasUnappliedEntries() {
+  return this->commit_idx_ > this->last_applied_idx_;
+}
+
+/**
+ * @brief raft core cycle, sleeps until the nearest heartbeat or election
+ * deadline and runs the expired timers
  *
  * @return EStatus
  */
 EStatus RaftServer::RunCycle() {
-  ResetRandomElectionTimeout();
   while (true) {
-    SPDLOG_INFO("heartbeat_tick_count_  " +
-                std::to_string(heartbeat_tick_count_));
-    SPDLOG_INFO("node role " + NodeRoleToStr(role_));
-    SPDLOG_INFO("commit idx {} applied idx {}",
-                this->commit_idx_,
-                this->last_applied_idx_);
-    heartbeat_tick_count_ += 1;
-    election_tick_count_ += 1;
-    if (heartbeat_tick_count_ == heartbeat_timeout_) {
-      if (this->role_ == NodeRaftRoleEnum::Leader) {
-        SPDLOG_INFO("heartbeat timeout");
-        this->SendHeartBeat();
-        heartbeat_tick_count_ = 0;
-      }
+    this->timer_wheel_->WaitForExpire(
+        std::max(this->heartbeat_timeout_, this->election_timeout_) *
+        this->tick_interval_);
+    this->timer_wheel_->RunExpired();
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief
+ *
+ */
+void RaftServer::HeartbeatTimeout() {
+  SPDLOG_INFO("node role " + NodeRoleToStr(role_));
+  SPDLOG_INFO("commit idx {} applied idx {}",
+              this->commit_idx_,
+              this->last_applied_idx_);
+  if (this->role_ == NodeRaftRoleEnum::Leader) {
+    SPDLOG_INFO("heartbeat timeout");
+    this->SendHeartBeat();
+  }
+  this->timer_wheel_->ResetTimer(this->heartbeat_timer_id_,
+                                heartbeat_timeout_ * tick_interval_);
+}
+
+/**
+ * @brief
+ *
+ */
+void RaftServer::ElectionTimeout() {
+  // re-arm first, the role transitions below may reset it again
+  ResetRandomElectionTimeout();
+  if (!election_running_) {
+    return;
+  }
+  if (this->role_ == NodeRaftRoleEnum::Follower) {
+    SPDLOG_INFO("start pre election in term {} ", current_term_);
+    this->BecomePreCandidate();
+    this->ElectionStart(true);
+  } else if (this->role_ == NodeRaftRoleEnum::PreCandidate) {
+    if (this->granted_votes_ > (this->nodes_.size() / 2)) {
+      this->BecomeCandidate();
+      this->ElectionStart(false);
+    } else {
+      this->BecomeFollower();
     }
-    if (election_tick_count_ >= election_timeout_ && election_running_) {
-      if (this->role_ == NodeRaftRoleEnum::Follower) {
-        SPDLOG_INFO("start pre election in term {} ", current_term_);
-        this->BecomePreCandidate();
-        this->ElectionStart(true);
-      } else if (this->role_ == NodeRaftRoleEnum::PreCandidate) {
-        if (this->granted_votes_ > (this->nodes_.size() / 2)) {
-          this->BecomeCandidate();
-          this->ElectionStart(false);
-        } else {
-          this->BecomeFollower();
-        }
-      } else if (this->role_ == NodeRaftRoleEnum::Candidate) {
-        if (this->granted_votes_ > (this->nodes_.size() / 2)) {
-          this->BecomeLeader();
-        } else {
-          this->BecomeFollower();
-        }
-      }
-      ResetRandomElectionTimeout();
+  } else if (this->role_ == NodeRaftRoleEnum::Candidate) {
+    if (this->granted_votes_ > (this->nodes_.size() / 2)) {
+      this->BecomeLeader();
+    } else {
+      this->BecomeFollower();
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(tick_interval_));
   }
-  return EStatus::kOk;
 }
 
 /**
@@ -192,99 +313,101 @@ EStatus RaftServer::SendAppendEntries() {
     return EStatus::kNotSupport;
   }
 
+  std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+
   for (auto node : this->nodes_) {
-    if (node->id == this->id_ ||
-        node->node_state == NodeStateEnum::LostConnection) {
+    if (node->id == this->id_) {
       continue;
     }
+    this->SendAppendEntriesToNode(node);
+  }
 
-    auto prev_log_index = node->next_log_index - 1;
-
-    SPDLOG_INFO("node prev_log_index {} node id {}", prev_log_index, node->id);
-    SPDLOG_INFO("current node fist log index {}",
-                this->log_store_->FirstIndex());
-
-    if (prev_log_index < this->log_store_->FirstIndex()) {
-      auto new_first_log_ent = this->log_store_->GetFirstEty();
-
-      RocksDBStorageImpl* snapshot_db = new RocksDBStorageImpl(snap_db_path_);
-      auto                kvs =
-          snapshot_db->PrefixScan("", 0, SNAPSHOTING_KEY_SCAN_PRE_COOUNT);
-      DirectoryTool::MkDir("/eraft/data/sst_send/");
-      uint64_t count = 1;
-      while (kvs.size() != 0) {
-        SPDLOG_INFO("scan find {} keys", kvs.size());
-        rocksdb::Options       options;
-        rocksdb::SstFileWriter sst_file_writer(rocksdb::EnvOptions(), options);
-        sst_file_writer.Open("/eraft/data/sst_send/" + std::to_string(count) +
-                             ".sst");
-        for (auto kv : kvs) {
-          SPDLOG_INFO("key {} -> val {}", kv.first, kv.second);
-          sst_file_writer.Put(kv.first, kv.second);
-        }
-        sst_file_writer.Finish();
-        kvs = snapshot_db->PrefixScan("",
-                                      count * SNAPSHOTING_KEY_SCAN_PRE_COOUNT,
-                                      SNAPSHOTING_KEY_SCAN_PRE_COOUNT);
-        count += 1;
-      }
-
-
-      //
-      // loop send sst files
-      //
-      auto snap_files = DirectoryTool::ListDirFiles("/eraft/data/sst_send/");
-      for (auto snapfile : snap_files) {
-        if (StringUtil::endsWith(snapfile, ".sst")) {
-          SPDLOG_INFO("snapfile {}", snapfile);
-          this->net_->SendFile(this, node, snapfile);
-        }
-      }
-
-      eraftkv::SnapshotReq* snap_req = new eraftkv::SnapshotReq();
-      snap_req->set_term(this->current_term_);
-      snap_req->set_leader_id(this->id_);
-      snap_req->set_last_included_index(new_first_log_ent->id());
-      snap_req->set_last_included_term(new_first_log_ent->term());
-      // snap_req->set_data("snapshotdata");
+  return EStatus::kOk;
+}
 
-      SPDLOG_INFO("send snapshot to node {} with req {}",
-                  node->id,
-                  snap_req->DebugString());
+/**
+ * @brief send append entries or a snapshot to one node according to its
+ * progress state, the caller holds raft_op_mutex_
+ *
+ * @param node
+ * @return EStatus
+ */
+EStatus RaftServer::SendAppendEntriesToNode(RaftNode* node) {
+  if (node->progress_state == ProgressStateEnum::Snapshot) {
+    return EStatus::kOk;
+  }
 
-      this->net_->SendSnapshot(this, node, snap_req);
+  auto prev_log_index = node->next_log_index - 1;
 
-      delete snap_req;
+  SPDLOG_INFO("node prev_log_index {} node id {}", prev_log_index, node->id);
+  SPDLOG_INFO("current node fist log index {}",
+              this->log_store_->FirstIndex());
 
-    } else {
-      auto prev_log_entry = this->log_store_->Get(prev_log_index);
+  if (prev_log_index < this->log_store_->FirstIndex()) {
+    // wait for a heartbeat to reach the node before building a snapshot
+    if (node->node_state == NodeStateEnum::LostConnection) {
+      return EStatus::kOk;
+    }
+    // building and sending the sst files takes long, the snapshot task
+    // runs outside raft_op_mutex_ so the other nodes keep replicating. the
+    // node stays in snapshot state until the task is done with it
+    node->progress_state = ProgressStateEnum::Snapshot;
+    this->ScheduleSnapshot(node);
+  } else {
+    // a probing node gets one request at a time until its match point is
+    // found, a replicating node has batches pipelined until the in flight
+    // window is full. next_log_index is advanced optimistically and rewound
+    // in HandleAppendEntriesResp if a batch is rejected or lost
+    int64_t inflight_window =
+        node->progress_state == ProgressStateEnum::Replicate
+            ? this->max_inflight_append_reqs_
+            : 1;
+    while (node->inflight_append_reqs < inflight_window) {
+      prev_log_index = node->next_log_index - 1;
       auto copy_cnt = this->log_store_->LastIndex() - prev_log_index;
+      if (copy_cnt <= 0 && node->inflight_append_reqs > 0) {
+        break;
+      }
       if (copy_cnt > this->max_entries_per_append_req_) {
         copy_cnt = this->max_entries_per_append_req_;
       }
 
-      eraftkv::AppendEntriesReq* append_req = new eraftkv::AppendEntriesReq();
-      append_req->set_is_heartbeat(false);
+      eraftkv::AppendEntriesReq append_req;
+      append_req.set_is_heartbeat(false);
       if (copy_cnt > 0) {
-        auto etys_to_be_send = this->log_store_->Gets(
-            prev_log_index + 1, prev_log_index + copy_cnt);
-        for (auto ety : etys_to_be_send) {
-          eraftkv::Entry* new_ety = append_req->add_entries();
-          new_ety->set_id(ety->id());
-          new_ety->set_e_type(ety->e_type());
-          new_ety->set_term(ety->term());
-          new_ety->set_allocated_data(ety->mutable_data());
+        this->log_store_->Gets(prev_log_index + 1,
+                               prev_log_index + copy_cnt,
+                               &this->append_etys_);
+        int64_t batch_bytes = 0;
+        for (auto& ety : this->append_etys_) {
+          int64_t ety_bytes = ety.ByteSizeLong();
+          // an entry larger than the budget is still sent on its own
+          if (append_req.entries_size() > 0 &&
+              batch_bytes + ety_bytes > this->max_bytes_per_append_req_) {
+            break;
+          }
+          batch_bytes += ety_bytes;
+          // the codec fields travel with the compressed payload
+          append_req.add_entries()->Swap(&ety);
         }
       }
-      append_req->set_term(this->current_term_);
-      append_req->set_leader_id(this->id_);
-      append_req->set_prev_log_index(prev_log_index);
-      append_req->set_prev_log_term(prev_log_entry->term());
-      append_req->set_leader_commit(this->commit_idx_);
-
-      this->net_->SendAppendEntries(this, node, append_req);
-      delete prev_log_entry;
-      delete append_req;
+      append_req.set_term(this->current_term_);
+      append_req.set_leader_id(this->id_);
+      append_req.set_prev_log_index(prev_log_index);
+      append_req.set_prev_log_term(this->log_store_->Term(prev_log_index));
+      append_req.set_leader_commit(this->commit_idx_);
+
+      int64_t sent_cnt = append_req.entries_size();
+      auto    status = this->net_->SendAppendEntries(this, node, &append_req);
+      if (status != EStatus::kOk) {
+        break;
+      }
+      node->inflight_append_reqs += 1;
+      node->next_log_index = prev_log_index + sent_cnt + 1;
+      if (sent_cnt == 0 ||
+          node->next_log_index > this->log_store_->LastIndex()) {
+        break;
+      }
     }
   }
 
@@ -298,14 +421,289 @@ EStatus RaftServer::SendAppendEntries() {
  */
 EStatus RaftServer::ApplyEntries() {
   if (!this->IsSnapshoting()) {
+    auto last_applied_idx = this->last_applied_idx_;
     this->store_->ApplyLog(this, 0, 0);
+    if (this->last_applied_idx_ != last_applied_idx) {
+      {
+        std::lock_guard<std::mutex> lock(this->read_index_mutex_);
+        this->read_index_cond_.notify_all();
+      }
+      this->ReleaseLogCache();
+    }
+  }
+  return EStatus::kOk;
+}
+
+void RaftServer::StageEntries(const std::vector<eraftkv::Entry*>& etys,
+                              bool                                move) {
+  if (etys.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->staged_mutex_);
+  int64_t                     first_idx = etys.front()->id();
+  while (!this->staged_etys_.empty() &&
+         this->staged_etys_.back().id() >= first_idx) {
+    this->staged_etys_.pop_back();
+  }
+  if (!this->staged_etys_.empty() &&
+      this->staged_etys_.back().id() + 1 != first_idx) {
+    this->staged_etys_.clear();
+  }
+  for (auto ety : etys) {
+    this->staged_etys_.emplace_back();
+    if (move) {
+      this->staged_etys_.back().Swap(ety);
+    } else {
+      this->staged_etys_.back().CopyFrom(*ety);
+    }
+  }
+  // a follower behind the leader commit or a leader without a quorum keeps
+  // at most a queue worth of entries, the rest is read from the log store
+  while (this->staged_etys_.size() > COMMITTED_ENTRY_QUEUE_SIZE) {
+    this->staged_etys_.pop_front();
+  }
+}
+
+void RaftServer::QueueCommittedEntries(int64_t commit_idx) {
+  std::lock_guard<std::mutex> lock(this->staged_mutex_);
+  while (!this->staged_etys_.empty() &&
+         this->staged_etys_.front().id() <= commit_idx) {
+    // an entry that finds the queue full is dropped, the apply thread reads
+    // it from the log store
+    this->committed_queue_.Push(&this->staged_etys_.front());
+    this->staged_etys_.pop_front();
+  }
+}
+
+EStatus RaftServer::TakeCommittedEntries(std::vector<eraftkv::Entry>* etys) {
+  int64_t next_idx = this->last_applied_idx_ + 1;
+  int64_t commit_idx = this->commit_idx_;
+  size_t  count = 0;
+  while (next_idx <= commit_idx) {
+    eraftkv::Entry* front = this->committed_queue_.Front();
+    if (front != nullptr && front->id() < next_idx) {
+      // applied already, through an installed snapshot or a log store read
+      this->committed_queue_.Pop();
+      continue;
+    }
+    if (front != nullptr && front->id() == next_idx) {
+      if (count == etys->size()) {
+        etys->emplace_back();
+      }
+      (*etys)[count++].Swap(front);
+      this->committed_queue_.Pop();
+      next_idx++;
+      continue;
+    }
+    int64_t end_idx = commit_idx;
+    if (front != nullptr) {
+      end_idx = std::min(commit_idx, front->id() - 1);
+    }
+    this->log_store_->Gets(next_idx, end_idx, &this->fallback_etys_);
+    for (auto& ety : this->fallback_etys_) {
+      if (count == etys->size()) {
+        etys->emplace_back();
+      }
+      (*etys)[count++].Swap(&ety);
+    }
+    if (static_cast<int64_t>(this->fallback_etys_.size()) !=
+        end_idx - next_idx + 1) {
+      break;
+    }
+    next_idx = end_idx + 1;
+  }
+  etys->resize(count);
+  return EStatus::kOk;
+}
+
+void RaftServer::ReleaseLogCache() {
+  int64_t release_idx = this->last_applied_idx_;
+  if (this->role_ == NodeRaftRoleEnum::Leader) {
+    // a down node catches up from the log db, it does not pin the cache
+    std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+    for (auto node : this->nodes_) {
+      if (node->id == this->id_ || node->node_state == NodeStateEnum::Down) {
+        continue;
+      }
+      release_idx = std::min(release_idx, node->match_log_index);
+    }
+  }
+  this->log_store_->ReleaseCache(release_idx + 1);
+}
+
+/**
+ * @brief obtain a read index and wait until the state machine applied it.
+ * the leader confirms its own commit index, a follower asks the leader for it
+ * so reads can be served by any replica
+ *
+ * @param read_index
+ * @return EStatus
+ */
+EStatus RaftServer::ReadIndex(int64_t* read_index) {
+  auto deadline = std::chrono::system_clock::now() +
+                  std::chrono::milliseconds(READ_INDEX_TIMEOUT_MS);
+  EStatus st = this->role_ == NodeRaftRoleEnum::Leader
+                   ? this->ConfirmLeaderReadIndex(read_index, deadline)
+                   : this->ForwardReadIndex(read_index);
+  if (st != EStatus::kOk) {
+    return st;
+  }
+  std::unique_lock<std::mutex> lock(this->read_index_mutex_);
+  if (!this->read_index_cond_.wait_until(lock, deadline, [this, read_index] {
+        return this->last_applied_idx_ >= *read_index;
+      })) {
+    return EStatus::kError;
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief confirm leadership with a heartbeat quorum for the commit index
+ * recorded at call time. concurrent callers share one heartbeat round
+ *
+ * @param read_index
+ * @param deadline
+ * @return EStatus
+ */
+EStatus RaftServer::ConfirmLeaderReadIndex(
+    int64_t*                              read_index,
+    std::chrono::system_clock::time_point deadline) {
+  if (this->role_ != NodeRaftRoleEnum::Leader) {
+    return EStatus::kNotSupport;
+  }
+  // the commit index is only up to date once an entry of the leader's term
+  // (the no-op appended in BecomeLeader) is committed
+  if (this->log_store_->Term(this->commit_idx_) != this->current_term_) {
+    return EStatus::kNotSupport;
+  }
+
+  std::unique_lock<std::mutex> lock(this->read_index_mutex_);
+  *read_index = this->commit_idx_;
+  // any heartbeat round sent after the read index was recorded confirms it,
+  // a valid lease confirms it without a round trip
+  int64_t wait_message_index = this->message_index_ + 1;
+  while (this->last_acked_message_index_ < wait_message_index &&
+         !(this->read_mode_ == ReadModeEnum::ReadOnlyLeaseBased &&
+           this->HasLeaderLease())) {
+    if (this->role_ != NodeRaftRoleEnum::Leader) {
+      return EStatus::kNotSupport;
+    }
+    if (!this->read_index_round_inflight_) {
+      this->read_index_round_inflight_ = true;
+      lock.unlock();
+      this->SendHeartBeat();
+      lock.lock();
+      continue;
+    }
+    if (this->read_index_cond_.wait_until(lock, deadline) ==
+        std::cv_status::timeout) {
+      return EStatus::kError;
+    }
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief the follower's log matches the leader's up to the returned index
+ * once it is applied locally, so waiting for it is enough for a linearizable
+ * local read
+ *
+ * @param read_index
+ * @return EStatus
+ */
+EStatus RaftServer::ForwardReadIndex(int64_t* read_index) {
+  int64_t   leader_id = this->leader_id_;
+  RaftNode* leader_node = nullptr;
+  for (auto node : this->nodes_) {
+    if (node->id == leader_id && node->id != this->id_) {
+      leader_node = node;
+    }
+  }
+  if (leader_node == nullptr) {
+    return EStatus::kNotSupport;
+  }
+  eraftkv::ReadIndexReq req;
+  req.set_from_id(this->id_);
+  req.set_term(this->current_term_);
+  eraftkv::ReadIndexResp resp;
+  if (this->net_->SendReadIndex(this, leader_node, &req, &resp) !=
+      EStatus::kOk) {
+    return EStatus::kError;
+  }
+  if (!resp.success()) {
+    SPDLOG_DEBUG("read index rejected by {}, leader {}",
+                 leader_node->address,
+                 resp.leader_id());
+    return EStatus::kNotSupport;
+  }
+  *read_index = resp.read_index();
+  return EStatus::kOk;
+}
+
+/**
+ * @brief the leader lease starts when a heartbeat round acked by a quorum was
+ * sent, no other node can win an election within the minimum election timeout
+ * after that, less the clock drift bound. caller holds read_index_mutex_
+ *
+ * @return true
+ * @return false
+ */
+bool RaftServer::HasLeaderLease() {
+  if (this->role_ != NodeRaftRoleEnum::Leader) {
+    return false;
+  }
+  auto                 now_ms = TimeUtil::SteadyNowMs();
+  std::vector<int64_t> ack_times;
+  for (auto node : this->nodes_) {
+    if (node->node_state == NodeStateEnum::Down) {
+      continue;
+    }
+    ack_times.push_back(node->id == this->id_ ? now_ms
+                                              : node->heartbeat_ack_time_ms);
+  }
+  if (ack_times.empty()) {
+    return false;
+  }
+  std::sort(ack_times.begin(), ack_times.end(), std::greater<int64_t>());
+  int64_t lease_start_ms = ack_times[ack_times.size() / 2];
+  int64_t lease_ms = this->base_election_timeout_ * this->tick_interval_ -
+                     this->clock_drift_bound_ms_;
+  return lease_start_ms > 0 && now_ms < lease_start_ms + lease_ms;
+}
+
+/**
+ * @brief recompute the highest heartbeat round acked by a quorum, caller
+ * holds read_index_mutex_
+ *
+ * @return EStatus
+ */
+EStatus RaftServer::UpdateReadIndexQuorum() {
+  std::vector<int64_t> acked_idxs;
+  for (auto node : this->nodes_) {
+    if (node->node_state == NodeStateEnum::Down) {
+      continue;
+    }
+    acked_idxs.push_back(node->id == this->id_ ? this->message_index_
+                                               : node->acked_message_index);
+  }
+  if (acked_idxs.empty()) {
+    return EStatus::kOk;
   }
+  std::sort(acked_idxs.begin(), acked_idxs.end(), std::greater<int64_t>());
+  int64_t quorum_acked_idx = acked_idxs[acked_idxs.size() / 2];
+  if (quorum_acked_idx > this->last_acked_message_index_) {
+    this->last_acked_message_index_ = quorum_acked_idx;
+  }
+  if (this->last_acked_message_index_ >= this->message_index_) {
+    this->read_index_round_inflight_ = false;
+  }
+  this->read_index_cond_.notify_all();
   return EStatus::kOk;
 }
 
 bool RaftServer::IsUpToDate(int64_t last_idx, int64_t term) {
   return last_idx >= this->log_store_->LastIndex() &&
-         term >= this->log_store_->GetLastEty()->term();
+         term >= this->log_store_->LastTerm();
 }
 
 /**
@@ -323,6 +721,20 @@ EStatus RaftServer::HandleRequestVoteReq(RaftNode* from_node,
   resp->set_prevote(req->prevote());
   SPDLOG_INFO("handle vote req " + req->DebugString());
 
+  // with lease reads the leader serves reads alone until its lease expires,
+  // do not help elect another leader while the current one is heard from
+  if (this->read_mode_ == ReadModeEnum::ReadOnlyLeaseBased &&
+      this->leader_id_ != -1 && this->leader_id_ != req->candidtate_id()) {
+    bool leader_alive =
+        this->role_ == NodeRaftRoleEnum::Leader ||
+        TimeUtil::SteadyNowMs() - this->last_leader_contact_ms_ <
+            this->base_election_timeout_ * this->tick_interval_;
+    if (leader_alive) {
+      resp->set_vote_granted(false);
+      return EStatus::kOk;
+    }
+  }
+
   if (this->current_term_ > req->term()) {
     resp->set_vote_granted(false);
     return EStatus::kOk;
@@ -345,7 +757,120 @@ EStatus RaftServer::HandleRequestVoteReq(RaftNode* from_node,
     this->voted_for_ = req->candidtate_id();
 
     ResetRandomElectionTimeout();
-    election_tick_count_ = 0;
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief the sender thread is started on the first snapshot, most groups never
+ * send one
+ *
+ * @param node
+ */
+void RaftServer::ScheduleSnapshot(RaftNode* node) {
+  std::lock_guard<std::mutex> lock(this->snapshot_mutex_);
+  if (!this->snapshot_running_) {
+    if (this->snapshot_thread_.joinable()) {
+      // the server is being deleted
+      return;
+    }
+    this->snapshot_running_ = true;
+    this->snapshot_thread_ = std::thread(&RaftServer::RunSnapshotSender, this);
+  }
+  this->snapshot_queue_.push_back(node);
+  this->snapshot_cond_.notify_one();
+}
+
+/**
+ * @brief queued snapshots are dropped when the server is deleted, the nodes
+ * get a new one from the next leader
+ *
+ */
+void RaftServer::RunSnapshotSender() {
+  while (true) {
+    RaftNode* node;
+    {
+      std::unique_lock<std::mutex> lock(this->snapshot_mutex_);
+      this->snapshot_cond_.wait(lock, [this] {
+        return !this->snapshot_queue_.empty() || !this->snapshot_running_;
+      });
+      if (!this->snapshot_running_) {
+        return;
+      }
+      node = this->snapshot_queue_.front();
+      this->snapshot_queue_.pop_front();
+    }
+    this->SendSnapshotToNode(node);
+  }
+}
+
+/**
+ * @brief
+ *
+ * @param node
+ * @return EStatus
+ */
+EStatus RaftServer::SendSnapshotToNode(RaftNode* node) {
+  eraftkv::SnapshotReq snap_req;
+  {
+    std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+    if (this->role_ != NodeRaftRoleEnum::Leader) {
+      node->progress_state = ProgressStateEnum::Probe;
+      return EStatus::kNotSupport;
+    }
+    int64_t snap_index = this->log_store_->FirstIndex();
+    snap_req.set_term(this->current_term_);
+    snap_req.set_leader_id(this->id_);
+    snap_req.set_last_included_index(snap_index);
+    snap_req.set_last_included_term(this->log_store_->Term(snap_index));
+  }
+
+  // files of the last snapshot must not be sent again
+  std::string send_dir = this->SnapshotSendDir();
+  DirectoryTool::DeleteDir(send_dir);
+  DirectoryTool::MkDir(send_dir);
+  RocksDBStorageImpl* snapshot_db = new RocksDBStorageImpl(snap_db_path_);
+  auto kvs = snapshot_db->PrefixScan("", 0, SNAPSHOTING_KEY_SCAN_PRE_COOUNT);
+  uint64_t count = 1;
+  while (kvs.size() != 0) {
+    SPDLOG_INFO("scan find {} keys", kvs.size());
+    rocksdb::Options       options;
+    rocksdb::SstFileWriter sst_file_writer(rocksdb::EnvOptions(), options);
+    sst_file_writer.Open(send_dir + std::to_string(count) + ".sst");
+    for (auto kv : kvs) {
+      SPDLOG_INFO("key {} -> val {}", kv.first, kv.second);
+      sst_file_writer.Put(kv.first, kv.second);
+    }
+    sst_file_writer.Finish();
+    kvs = snapshot_db->PrefixScan("",
+                                  count * SNAPSHOTING_KEY_SCAN_PRE_COOUNT,
+                                  SNAPSHOTING_KEY_SCAN_PRE_COOUNT);
+    count += 1;
+  }
+  delete snapshot_db;
+
+  //
+  // loop send sst files
+  //
+  auto snap_files = DirectoryTool::ListDirFiles(send_dir);
+  for (auto snapfile : snap_files) {
+    if (StringUtil::endsWith(snapfile, ".sst")) {
+      SPDLOG_INFO("snapfile {}", snapfile);
+      this->net_->SendFile(this, node, snapfile);
+    }
+  }
+
+  SPDLOG_INFO(
+      "send snapshot to node {} with req {}", node->id, snap_req.DebugString());
+
+  // the resp handler moves the node back to probe, a snapshot that never
+  // reached the node is retried on the next round
+  if (this->net_->SendSnapshot(this, node, &snap_req) != EStatus::kOk) {
+    std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+    if (node->progress_state == ProgressStateEnum::Snapshot) {
+      node->progress_state = ProgressStateEnum::Probe;
+    }
+    return EStatus::kError;
   }
   return EStatus::kOk;
 }
@@ -356,6 +881,22 @@ EStatus RaftServer::HandleRequestVoteReq(RaftNode* from_node,
  * @return EStatus
  */
 EStatus RaftServer::SendHeartBeat() {
+  // read index rounds are sent from the rpc threads, the node progress and
+  // the node list are guarded by raft_op_mutex_, taken before
+  // read_index_mutex_ as the resp handler does
+  std::lock_guard<std::mutex> op_lock(this->raft_op_mutex_);
+  int64_t                     message_index;
+  {
+    std::lock_guard<std::mutex> lock(this->read_index_mutex_);
+    message_index = ++this->message_index_;
+    this->read_index_round_inflight_ = true;
+    this->heartbeat_send_times_.push_back(
+        std::make_pair(message_index, TimeUtil::SteadyNowMs()));
+    if (this->heartbeat_send_times_.size() > HEARTBEAT_SEND_TIMES_KEEP) {
+      this->heartbeat_send_times_.pop_front();
+    }
+    this->UpdateReadIndexQuorum();
+  }
   for (auto node : this->nodes_) {
     if (node->id == this->id_ || node->node_state == NodeStateEnum::Down) {
       continue;
@@ -367,14 +908,18 @@ EStatus RaftServer::SendHeartBeat() {
     SPDLOG_INFO("current node first log index {}",
                 this->log_store_->FirstIndex());
 
-    eraftkv::AppendEntriesReq* append_req = new eraftkv::AppendEntriesReq();
-    append_req->set_is_heartbeat(true);
-    append_req->set_leader_id(this->id_);
-    append_req->set_term(this->current_term_);
-    append_req->set_leader_commit(this->commit_idx_);
-    append_req->set_prev_log_index(prev_log_index);
-
-    this->net_->SendAppendEntries(this, node, append_req);
+    eraftkv::AppendEntriesReq append_req;
+    append_req.set_is_heartbeat(true);
+    append_req.set_message_index(message_index);
+    append_req.set_leader_id(this->id_);
+    append_req.set_term(this->current_term_);
+    // a heartbeat carries no entries, the node may only commit what it is
+    // known to hold, its log past match_log_index may be from an old term
+    append_req.set_leader_commit(
+        std::min(this->commit_idx_, node->match_log_index));
+    append_req.set_prev_log_index(prev_log_index);
+
+    this->net_->SendAppendEntries(this, node, &append_req);
   }
 
   return EStatus::kOk;
@@ -402,7 +947,8 @@ EStatus RaftServer::HandleRequestVoteResp(RaftNode* from_node,
         SPDLOG_INFO(" node {} get majority prevotes in term {}",
                     this->id_,
                     this->current_term_);
-        this->election_tick_count_ = this->election_timeout_;
+        // move on to the real election without waiting out the timeout
+        this->timer_wheel_->ResetTimer(this->election_timer_id_, 0);
       }
     }
   }
@@ -414,8 +960,9 @@ EStatus RaftServer::HandleRequestVoteResp(RaftNode* from_node,
         SPDLOG_INFO("node {} get majority votes in term {}",
                     this->id_,
                     this->current_term_);
-        this->BecomeLeader();
-        this->granted_votes_ = 0;
+        // the votes arrive on the rpc thread, the election timer thread
+        // makes the node leader so it only happens once
+        this->timer_wheel_->ResetTimer(this->election_timer_id_, 0);
       }
     } else {
       if (resp->leader_id() != -1) {
@@ -446,28 +993,146 @@ EStatus RaftServer::Propose(std::string payload,
     return EStatus::kOk;
   }
   // TODO: reject when snapshoting
-  eraftkv::Entry* new_ety = new eraftkv::Entry();
-  new_ety->set_data(payload);
-  new_ety->set_id(this->log_store_->LastIndex() + 1);
-  new_ety->set_term(this->current_term_);
-  new_ety->set_e_type(eraftkv::EntryType::Normal);
-
-  this->log_store_->Append(new_ety);
+  return this->EnqueueProposal(std::move(payload),
+                               eraftkv::EntryType::Normal,
+                               new_log_index,
+                               new_log_term,
+                               is_success);
+}
 
-  for (auto node : this->nodes_) {
-    if (node->id == this->id_) {
-      node->match_log_index = new_ety->id();
-      node->next_log_index = node->match_log_index + 1;
+/**
+ * @brief queue a proposal for group commit and wait until the batch it joined
+ * is appended to the log. the first caller to find no batch running leads the
+ * next one: it waits propose_batch_window_us_ (or until
+ * propose_batch_max_bytes_ are queued) then commits everything queued
+ *
+ * @param payload
+ * @param e_type
+ * @param new_log_index
+ * @param new_log_term
+ * @param is_success
+ * @return EStatus
+ */
+EStatus RaftServer::EnqueueProposal(std::string        payload,
+                                    eraftkv::EntryType e_type,
+                                    int64_t*           new_log_index,
+                                    int64_t*           new_log_term,
+                                    bool*              is_success) {
+  ProposalReq proposal;
+  proposal.payload = std::move(payload);
+  proposal.e_type = e_type;
+  proposal.compress_type = eraftkv::NoCompress;
+  proposal.raw_size = 0;
+  // compress in the proposing thread, the entry stays compressed in the log
+  // and on the wire until it is applied
+  if (e_type == eraftkv::EntryType::Normal) {
+    int64_t raw_size = proposal.payload.size();
+    if (CompressUtil::CompressPayload(this->log_compress_,
+                                      &proposal.payload)) {
+      proposal.compress_type = this->log_compress_;
+      proposal.raw_size = raw_size;
     }
   }
-  SendAppendEntries();
-  *new_log_index = new_ety->id();
-  *new_log_term = new_ety->term();
-  *is_success = true;
-  delete new_ety;
+  proposal.log_index = -1;
+  proposal.log_term = -1;
+  proposal.is_success = false;
+  proposal.done = false;
+
+  std::unique_lock<std::mutex> lock(this->propose_mutex_);
+  this->propose_queue_.push_back(&proposal);
+  this->propose_queue_bytes_ += proposal.payload.size();
+  this->propose_cond_.notify_all();
+  while (!proposal.done) {
+    if (this->propose_batch_running_) {
+      this->propose_cond_.wait(lock);
+      continue;
+    }
+    this->propose_batch_running_ = true;
+    this->propose_cond_.wait_for(
+        lock,
+        std::chrono::microseconds(this->propose_batch_window_us_),
+        [this] {
+          return this->propose_queue_bytes_ >= this->propose_batch_max_bytes_;
+        });
+    std::vector<ProposalReq*> batch;
+    int64_t                   batch_bytes = 0;
+    while (!this->propose_queue_.empty() &&
+           (batch.empty() || batch_bytes < this->propose_batch_max_bytes_)) {
+      auto req = this->propose_queue_.front();
+      this->propose_queue_.pop_front();
+      batch_bytes += req->payload.size();
+      batch.push_back(req);
+    }
+    this->propose_queue_bytes_ -= batch_bytes;
+    lock.unlock();
+    this->CommitProposalBatch(batch);
+    lock.lock();
+    for (auto req : batch) {
+      req->done = true;
+    }
+    this->propose_batch_running_ = false;
+    this->propose_cond_.notify_all();
+  }
+  *new_log_index = proposal.log_index;
+  *new_log_term = proposal.log_term;
+  *is_success = proposal.is_success;
   return EStatus::kOk;
 }
 
+/**
+ * @brief append a batch of proposals to the log with one write and start one
+ * replication round for all of them
+ *
+ * @param batch
+ * @return EStatus
+ */
+EStatus RaftServer::CommitProposalBatch(
+    const std::vector<ProposalReq*>& batch) {
+  // a follower append or a step down must not interleave with the batch, or
+  // entries of the old term could overwrite entries acked to a new leader
+  std::unique_lock<std::mutex> lock(this->raft_op_mutex_);
+  if (this->role_ != NodeRaftRoleEnum::Leader) {
+    return EStatus::kNotSupport;
+  }
+  int64_t new_log_index = this->log_store_->LastIndex();
+  int64_t new_log_term = this->current_term_;
+  this->propose_etys_.resize(batch.size());
+  this->propose_ety_ptrs_.clear();
+  for (size_t i = 0; i < batch.size(); i++) {
+    eraftkv::Entry* new_ety = &this->propose_etys_[i];
+    new_ety->set_data(std::move(batch[i]->payload));
+    new_ety->set_id(++new_log_index);
+    new_ety->set_term(new_log_term);
+    new_ety->set_e_type(batch[i]->e_type);
+    new_ety->set_compress_type(batch[i]->compress_type);
+    new_ety->set_data_size(batch[i]->raw_size);
+    this->propose_ety_ptrs_.push_back(new_ety);
+  }
+
+  // LAST_IDX goes to disk with the entries, the leader counts them toward
+  // the quorum as soon as they are appended
+  auto status = this->log_store_->AppendBatch(
+      this->propose_ety_ptrs_, this->commit_idx_, this->last_applied_idx_);
+  if (status == EStatus::kOk) {
+    for (size_t i = 0; i < batch.size(); i++) {
+      batch[i]->log_index = this->propose_etys_[i].id();
+      batch[i]->log_term = this->propose_etys_[i].term();
+      batch[i]->is_success = true;
+    }
+    // the log store keeps its own copy, the batch entries are handed on
+    this->StageEntries(this->propose_ety_ptrs_, true);
+    for (auto node : this->nodes_) {
+      if (node->id == this->id_) {
+        node->match_log_index = new_log_index;
+        node->next_log_index = node->match_log_index + 1;
+      }
+    }
+    lock.unlock();
+    SendAppendEntries();
+  }
+  return status;
+}
+
 /**
  * @brief
  *
@@ -480,13 +1145,23 @@ EStatus RaftServer::HandleAppendEntriesReq(RaftNode* from_node,
                                            const eraftkv::AppendEntriesReq* req,
                                            eraftkv::AppendEntriesResp* resp) {
   SPDLOG_INFO("handle ae {}", req->DebugString());
+  // pipelined requests of the leader are served on several rpc threads, a
+  // batch is matched against the log and appended as one step
+  std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
   ResetRandomElectionTimeout();
-  election_tick_count_ = 0;
 
   if (req->is_heartbeat()) {
     SPDLOG_INFO("recv heart beat");
+    // a stale leader must not get its leadership confirmed
+    if (req->term() < this->current_term_) {
+      resp->set_term(this->current_term_);
+      resp->set_success(false);
+      return EStatus::kOk;
+    }
     this->AdvanceCommitIndexForFollower(req->leader_commit());
     resp->set_success(true);
+    resp->set_term(req->term());
+    this->last_leader_contact_ms_ = TimeUtil::SteadyNowMs();
     this->leader_id_ = req->leader_id();
     this->current_term_ = req->term();
     this->BecomeFollower();
@@ -509,41 +1184,60 @@ EStatus RaftServer::HandleAppendEntriesReq(RaftNode* from_node,
 
   this->BecomeFollower();
   this->leader_id_ = req->leader_id();
+  this->last_leader_contact_ms_ = TimeUtil::SteadyNowMs();
 
   if (req->prev_log_index() < this->log_store_->FirstIndex()) {
     resp->set_term(0);
     resp->set_success(false);
     return EStatus::kOk;
   }
-  // after snapshoting GetLastEty()->term() is 0
+  // after snapshoting LastTerm() is 0
   if (!(this->MatchLog(req->prev_log_term(), req->prev_log_index()) ||
-        this->log_store_->GetLastEty()->term() == 0)) {
-    resp->set_success(true);
-    if (this->log_store_->LastIndex() < req->prev_log_index()) {
-      SPDLOG_INFO("log conflict with index {} term {}",
-                  this->log_store_->LastIndex(),
-                  this->log_store_->GetLastEty()->term());
-      resp->set_conflict_index(this->log_store_->LastIndex());
-      resp->set_conflict_term(this->log_store_->GetLastEty()->term());
-    } else {
-      // set term
-      resp->set_conflict_term(
-          this->log_store_->Get(req->prev_log_index())->term());
-      // find conflict index
-      auto index = req->prev_log_index();
-      while (index >= this->commit_idx_ &&
-             this->log_store_->Get(index)->term() == resp->conflict_term()) {
-        index -= 1;
+        this->log_store_->LastTerm() == 0)) {
+    // report the conflicting term and where it starts, current_index is the
+    // last index that may still match, so the leader can skip the whole
+    // term in one round trip
+    resp->set_success(false);
+    int64_t conflict_idx = std::min(this->log_store_->LastIndex(),
+                                    req->prev_log_index());
+    int64_t conflict_term = this->log_store_->Term(conflict_idx);
+    resp->set_conflict_term(conflict_term);
+    resp->set_conflict_index(
+        std::max(this->log_store_->FirstIndexOfTerm(conflict_term),
+                 this->commit_idx_ + 1));
+    resp->set_current_index(conflict_idx < req->prev_log_index()
+                                ? conflict_idx
+                                : conflict_idx - 1);
+    SPDLOG_INFO("log conflict with index {} term {}, term starts at {}",
+                conflict_idx,
+                conflict_term,
+                resp->conflict_index());
+  } else {
+    // entries already in the log with the same term are skipped and the log
+    // is only truncated at the first conflicting term, so a late or resent
+    // batch never drops the entries acked after it
+    std::vector<eraftkv::Entry*> etys;
+    for (auto& ety : req->entries()) {
+      if (etys.empty() && this->MatchLog(ety.term(), ety.id())) {
+        continue;
       }
-      resp->set_conflict_index(index);
+      etys.push_back(const_cast<eraftkv::Entry*>(&ety));
     }
-  } else {
-    for (auto ety : req->entries()) {
-      this->log_store_->Append(&ety);
-      this->log_store_->PersisLogMetaState(this->commit_idx_,
-                                           this->last_applied_idx_);
+    // all the new entries and the log meta go to the log db in one synced
+    // write
+    if (!etys.empty()) {
+      if (this->log_store_->AppendBatch(etys,
+                                        this->commit_idx_,
+                                        this->last_applied_idx_) !=
+          EStatus::kOk) {
+        resp->set_success(false);
+        return EStatus::kOk;
+      }
+      this->StageEntries(etys, false);
     }
-    this->AdvanceCommitIndexForFollower(req->leader_commit());
+    // entries past the batch may still be overwritten by this leader
+    this->AdvanceCommitIndexForFollower(std::min(
+        req->leader_commit(), req->prev_log_index() + req->entries_size()));
     resp->set_success(true);
   }
 
@@ -560,55 +1254,104 @@ EStatus RaftServer::HandleAppendEntriesReq(RaftNode* from_node,
 EStatus RaftServer::HandleAppendEntriesResp(RaftNode* from_node,
                                             eraftkv::AppendEntriesReq*  req,
                                             eraftkv::AppendEntriesResp* resp) {
-  if (role_ == NodeRaftRoleEnum::Leader) {
-    SPDLOG_INFO("send append entry resp {}", resp->DebugString());
+  std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+  // responses of requests sent in an older term carry no progress
+  if (role_ != NodeRaftRoleEnum::Leader ||
+      req->term() != this->current_term_) {
+    return EStatus::kOk;
+  }
+  // heartbeat acks confirm leadership for read index, not log progress
+  if (req->is_heartbeat()) {
+    if (resp == nullptr) {
+      return EStatus::kOk;
+    }
     if (resp->success()) {
-      for (auto node : this->nodes_) {
-        if (node->node_state == NodeStateEnum::Down) {
-          continue;
-        }
-        if (from_node->id == node->id) {
-          node->match_log_index = req->prev_log_index() + req->entries().size();
-          SPDLOG_INFO("update node {} match_log_index = {}",
-                      from_node->id,
-                      node->match_log_index);
-          node->next_log_index = node->match_log_index + 1;
-          this->AdvanceCommitIndexForLeader();
-        }
-      }
-    } else {
-      if (resp->term() > req->term()) {
-        this->BecomeFollower();
-        this->current_term_ = resp->term();
-        this->voted_for_ = -1;
-        this->store_->SaveRaftMeta(this, this->current_term_, this->voted_for_);
-      } else {
-        if (resp->conflict_term() == 0) {
-          for (auto node : this->nodes_) {
-            if (from_node->id == node->id) {
-              node->next_log_index = resp->conflict_index();
-            }
-          }
-        } else {
-          for (auto node : this->nodes_) {
-            if (node->node_state == NodeStateEnum::Down) {
-              continue;
-            }
-            if (from_node->id == node->id) {
-              node->next_log_index = resp->conflict_index();
-              for (int64_t i = resp->conflict_index();
-                   i >= this->log_store_->FirstIndex();
-                   i--) {
-                if (this->log_store_->Get(i)->term() == resp->conflict_term()) {
-                  node->next_log_index = i + 1;
-                  break;
-                }
-              }
-            }
+      std::lock_guard<std::mutex> read_lock(this->read_index_mutex_);
+      if (req->message_index() > from_node->acked_message_index) {
+        from_node->acked_message_index = req->message_index();
+        // the lease counts from when the acked heartbeat was sent
+        for (auto send_time : this->heartbeat_send_times_) {
+          if (send_time.first == req->message_index()) {
+            from_node->heartbeat_ack_time_ms = send_time.second;
+            break;
           }
         }
+        this->UpdateReadIndexQuorum();
+      }
+      // the node is reachable again, probe it if it lags with nothing in
+      // flight instead of waiting for the next proposal
+      if (from_node->match_log_index < this->log_store_->LastIndex() &&
+          from_node->inflight_append_reqs == 0) {
+        this->SendAppendEntriesToNode(from_node);
       }
+    } else if (resp->term() > this->current_term_) {
+      this->BecomeFollower();
+      this->current_term_ = resp->term();
+      this->voted_for_ = -1;
+      this->store_->SaveRaftMeta(this, this->current_term_, this->voted_for_);
+    }
+    return EStatus::kOk;
+  }
+  if (from_node->inflight_append_reqs > 0) {
+    from_node->inflight_append_reqs -= 1;
+  }
+  if (resp == nullptr) {
+    // rpc failed, resend from this batch when the node is reachable again
+    from_node->progress_state = ProgressStateEnum::Probe;
+    if (req->prev_log_index() >= from_node->match_log_index) {
+      from_node->next_log_index =
+          std::min(from_node->next_log_index, req->prev_log_index() + 1);
+    }
+    return EStatus::kOk;
+  }
+  SPDLOG_DEBUG("send append entry resp {}", resp->DebugString());
+  if (resp->success()) {
+    // the match point is found, start pipelining
+    if (from_node->progress_state == ProgressStateEnum::Probe) {
+      from_node->progress_state = ProgressStateEnum::Replicate;
+    }
+    // responses may arrive out of order, match index only moves forward
+    auto last_log_index = req->prev_log_index() + req->entries_size();
+    if (last_log_index > from_node->match_log_index) {
+      from_node->match_log_index = last_log_index;
+      from_node->next_log_index = std::max(from_node->next_log_index,
+                                           from_node->match_log_index + 1);
+      SPDLOG_INFO("update node {} match_log_index = {}",
+                  from_node->id,
+                  from_node->match_log_index);
+      this->AdvanceCommitIndexForLeader();
     }
+  } else {
+    if (resp->term() > req->term()) {
+      this->BecomeFollower();
+      this->current_term_ = resp->term();
+      this->voted_for_ = -1;
+      this->store_->SaveRaftMeta(this, this->current_term_, this->voted_for_);
+      return EStatus::kOk;
+    }
+    // ignore rejects of batches already matched, or sent behind a batch
+    // whose reject has rewound next_log_index
+    if (req->prev_log_index() < from_node->match_log_index ||
+        req->prev_log_index() >= from_node->next_log_index) {
+      return EStatus::kOk;
+    }
+    from_node->progress_state = ProgressStateEnum::Probe;
+    // if we have the conflicting term the follower matches up to the end of
+    // it, otherwise the whole term is skipped
+    int64_t next_log_index = resp->conflict_index();
+    int64_t last_of_term =
+        this->log_store_->LastIndexOfTerm(resp->conflict_term());
+    if (last_of_term != -1) {
+      next_log_index = std::min(last_of_term, resp->current_index()) + 1;
+    }
+    next_log_index = std::min(next_log_index, req->prev_log_index());
+    next_log_index = std::max(next_log_index, from_node->match_log_index + 1);
+    from_node->next_log_index = next_log_index;
+  }
+  // refill the in flight window, or resend from the rewound next_log_index,
+  // without waiting for the next proposal or heartbeat
+  if (from_node->next_log_index <= this->log_store_->LastIndex()) {
+    this->SendAppendEntriesToNode(from_node);
   }
   return EStatus::kOk;
 }
@@ -630,7 +1373,10 @@ EStatus RaftServer::HandleSnapshotReq(RaftNode*                   from_node,
   resp->set_term(this->current_term_);
   resp->set_success(false);
 
+  // files sent by a stale leader must not be ingested with the next snapshot
+  std::string recv_dir = this->SnapshotRecvDir();
   if (req->term() < this->current_term_) {
+    DirectoryTool::DeleteDir(recv_dir);
     this->is_snapshoting_ = false;
     return EStatus::kOk;
   }
@@ -646,10 +1392,11 @@ EStatus RaftServer::HandleSnapshotReq(RaftNode*                   from_node,
 
   resp->set_success(true);
 
-  auto snap_files = DirectoryTool::ListDirFiles("/eraft/data/sst_recv/");
+  auto snap_files = DirectoryTool::ListDirFiles(recv_dir);
   for (auto snapfile : snap_files) {
     this->store_->IngestSST(snapfile);
   }
+  DirectoryTool::DeleteDir(recv_dir);
 
   if (req->last_included_index() <= this->commit_idx_) {
     this->is_snapshoting_ = false;
@@ -683,7 +1430,7 @@ EStatus RaftServer::HandleSnapshotReq(RaftNode*                   from_node,
 bool RaftServer::MatchLog(int64_t term, int64_t index) {
   return (index <= this->log_store_->LastIndex() &&
           index >= this->log_store_->FirstIndex() &&
-          this->log_store_->Get(index)->term() == term);
+          this->log_store_->Term(index) == term);
 }
 
 
@@ -699,9 +1446,11 @@ EStatus RaftServer::AdvanceCommitIndexForLeader() {
   int64_t new_commit_index = match_idxs[match_idxs.size() / 2];
   if (new_commit_index > this->commit_idx_) {
     if (this->MatchLog(this->current_term_, new_commit_index)) {
+      this->QueueCommittedEntries(new_commit_index);
       this->commit_idx_ = new_commit_index;
       this->log_store_->PersisLogMetaState(this->commit_idx_,
                                            this->last_applied_idx_);
+      this->NotifyApply();
     }
   }
   return EStatus::kOk;
@@ -710,15 +1459,26 @@ EStatus RaftServer::AdvanceCommitIndexForLeader() {
 EStatus RaftServer::AdvanceCommitIndexForFollower(int64_t leader_commit) {
 
   int64_t new_commit_index =
-      std::min(leader_commit, this->log_store_->GetLastEty()->id());
+      std::min(leader_commit, this->log_store_->LastIndex());
   if (new_commit_index > this->commit_idx_) {
+    this->QueueCommittedEntries(new_commit_index);
     this->commit_idx_ = new_commit_index;
     this->log_store_->PersisLogMetaState(this->commit_idx_,
                                          this->last_applied_idx_);
+    this->NotifyApply();
   }
   return EStatus::kOk;
 }
 
+void RaftServer::NotifyApply() {
+  std::lock_guard<std::mutex> lock(this->apply_mutex_);
+  if (this->apply_notifier_) {
+    this->apply_notifier_();
+  } else {
+    this->apply_cond_.notify_one();
+  }
+}
+
 
 /**
  * @brief
@@ -730,6 +1490,17 @@ EStatus RaftServer::AdvanceCommitIndexForFollower(int64_t leader_commit) {
 EStatus RaftServer::HandleSnapshotResp(RaftNode*              from_node,
                                        eraftkv::SnapshotReq*  req,
                                        eraftkv::SnapshotResp* resp) {
+  // called from the snapshot sender thread
+  std::lock_guard<std::mutex> lock(this->raft_op_mutex_);
+  if (resp == nullptr || !resp->success()) {
+    // let the next round probe the node and resend the snapshot
+    for (auto node : this->nodes_) {
+      if (from_node->id == node->id &&
+          node->progress_state == ProgressStateEnum::Snapshot) {
+        node->progress_state = ProgressStateEnum::Probe;
+      }
+    }
+  }
   if (resp != nullptr) {
     SPDLOG_INFO("handle snapshot resp {}", resp->DebugString());
     if (this->role_ == NodeRaftRoleEnum::Leader &&
@@ -739,11 +1510,12 @@ EStatus RaftServer::HandleSnapshotResp(RaftNode*              from_node,
         this->current_term_ = resp->term();
         this->voted_for_ = -1;
         this->store_->SaveRaftMeta(this, this->current_term_, this->voted_for_);
-      } else {
+      } else if (resp->success()) {
         for (auto node : this->nodes_) {
           if (from_node->id == node->id) {
             node->match_log_index = req->last_included_index();
             node->next_log_index = req->last_included_index() + 1;
+            node->progress_state = ProgressStateEnum::Probe;
             SPDLOG_INFO("update node {} match_log_index {}, next_log_index{} ",
                         node->address,
                         node->match_log_index,
@@ -756,6 +1528,30 @@ EStatus RaftServer::HandleSnapshotResp(RaftNode*              from_node,
   return EStatus::kOk;
 }
 
+/**
+ * @brief
+ *
+ * @param req
+ * @param resp
+ * @return EStatus
+ */
+EStatus RaftServer::HandleReadIndexReq(const eraftkv::ReadIndexReq* req,
+                                       eraftkv::ReadIndexResp*      resp) {
+  int64_t read_index = 0;
+  auto    deadline = std::chrono::system_clock::now() +
+                  std::chrono::milliseconds(READ_INDEX_TIMEOUT_MS);
+  EStatus st = EStatus::kNotSupport;
+  // a follower that already saw a newer term must not accept our index
+  if (req->term() <= this->current_term_) {
+    st = this->ConfirmLeaderReadIndex(&read_index, deadline);
+  }
+  resp->set_success(st == EStatus::kOk);
+  resp->set_read_index(read_index);
+  resp->set_term(this->current_term_);
+  resp->set_leader_id(this->leader_id_);
+  return st;
+}
+
 /**
  * @brief
  *
@@ -790,32 +1586,11 @@ EStatus RaftServer::ProposeConfChange(std::string payload,
     return EStatus::kOk;
   }
 
-  eraftkv::Entry* new_ety = new eraftkv::Entry();
-  new_ety->set_data(payload);
-  new_ety->set_id(this->log_store_->LastIndex() + 1);
-  new_ety->set_term(this->current_term_);
-  new_ety->set_e_type(eraftkv::EntryType::ConfChange);
-
-  this->log_store_->Append(new_ety);
-
-  for (auto node : this->nodes_) {
-    if (node->node_state == NodeStateEnum::Down) {
-      continue;
-    }
-    if (node->id == this->id_) {
-      node->match_log_index = new_ety->id();
-      node->next_log_index = node->match_log_index + 1;
-    }
-  }
-
-  SendAppendEntries();
-
-  *new_log_index = new_ety->id();
-  *new_log_term = new_ety->term();
-  *is_success = true;
-
-  delete new_ety;
-  return EStatus::kOk;
+  return this->EnqueueProposal(std::move(payload),
+                               eraftkv::EntryType::ConfChange,
+                               new_log_index,
+                               new_log_term,
+                               is_success);
 }
 
 
@@ -825,15 +1600,31 @@ EStatus RaftServer::ProposeConfChange(std::string payload,
  * @return EStatus
  */
 EStatus RaftServer::BecomeLeader() {
+  // append a no-op entry of the new term, once it commits the leader knows
+  // the latest commit index and can serve read index requests
+  eraftkv::Entry noop_ety;
+  noop_ety.set_id(this->log_store_->LastIndex() + 1);
+  noop_ety.set_term(this->current_term_);
+  noop_ety.set_e_type(eraftkv::EntryType::NoOp);
+  this->log_store_->Append(&noop_ety);
+  this->StageEntries({&noop_ety}, false);
+
   this->role_ = NodeRaftRoleEnum::Leader;
-  heartbeat_tick_count_ = 0;
   this->leader_id_ = this->id_;
   for (auto node : this->nodes_) {
-    node->next_log_index = this->log_store_->LastIndex() + 1;
+    node->next_log_index = noop_ety.id();
     node->match_log_index = 0;
+    node->inflight_append_reqs = 0;
+    node->progress_state = ProgressStateEnum::Probe;
+    if (node->id == this->id_) {
+      node->match_log_index = noop_ety.id();
+      node->next_log_index = noop_ety.id() + 1;
+    }
   }
   this->SendHeartBeat();
-  heartbeat_tick_count_ = 0;
+  this->SendAppendEntries();
+  this->timer_wheel_->ResetTimer(this->heartbeat_timer_id_,
+                                heartbeat_timeout_ * tick_interval_);
   election_running_ = false;
   return EStatus::kOk;
 }
@@ -846,6 +1637,7 @@ EStatus RaftServer::BecomeLeader() {
 EStatus RaftServer::BecomeFollower() {
   this->role_ = NodeRaftRoleEnum::Follower;
   ResetRandomElectionTimeout();
+  this->read_index_cond_.notify_all();
   return EStatus::kOk;
 }
 
@@ -890,17 +1682,17 @@ EStatus RaftServer::ElectionStart(bool is_prevote) {
   this->granted_votes_ = 1;
   this->leader_id_ = -1;
   this->voted_for_ = this->id_;
-  eraftkv::RequestVoteReq* vote_req = new eraftkv::RequestVoteReq();
+  eraftkv::RequestVoteReq vote_req;
   if (is_prevote) {
-    vote_req->set_term(this->current_term_ + 1);
-    vote_req->set_prevote(true);
+    vote_req.set_term(this->current_term_ + 1);
+    vote_req.set_prevote(true);
   } else {
     this->current_term_ += 1;
-    vote_req->set_term(this->current_term_);
+    vote_req.set_term(this->current_term_);
   }
-  vote_req->set_candidtate_id(this->id_);
-  vote_req->set_last_log_idx(this->log_store_->LastIndex());
-  vote_req->set_last_log_term(this->log_store_->GetLastEty()->term());
+  vote_req.set_candidtate_id(this->id_);
+  vote_req.set_last_log_idx(this->log_store_->LastIndex());
+  vote_req.set_last_log_term(this->log_store_->LastTerm());
   this->store_->SaveRaftMeta(this, this->current_term_, this->voted_for_);
 
   for (auto node : this->nodes_) {
@@ -911,8 +1703,8 @@ EStatus RaftServer::ElectionStart(bool is_prevote) {
 
     SPDLOG_INFO("send request vote to {} with param {}",
                 node->address,
-                vote_req->DebugString());
-    this->net_->SendRequestVote(this, node, vote_req);
+                vote_req.DebugString());
+    this->net_->SendRequestVote(this, node, &vote_req);
   }
 
   return EStatus::kOk;
@@ -937,12 +1729,17 @@ EStatus RaftServer::SnapshotingStart(int64_t ety_idx) {
 
   SPDLOG_INFO("start snapshoting with index {}", ety_idx);
 
+  // the checkpoint flushes the applied data, only then is the log below it
+  // no longer needed to recover the kv db
+  if (this->store_->CreateCheckpoint(snap_db_path_) != EStatus::kOk) {
+    this->is_snapshoting_ = false;
+    return EStatus::kError;
+  }
+
   this->log_store_->EraseBefore(ety_idx);
   // reset first log index
   this->log_store_->ResetFirstLogEntry(this->current_term_, ety_idx);
 
-  this->store_->CreateCheckpoint(snap_db_path_);
-
   this->is_snapshoting_ = false;
 
   return EStatus::kOk;
@@ -33,13 +33,21 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
+#include "committed_entry_queue.h"
 #include "eraftkv.pb.h"
 #include "estatus.h"
 #include "raft_config.h"
 #include "raft_node.h"
+#include "timer_wheel.h"
 
 
 enum NodeRaftRoleEnum { None, Follower, PreCandidate, Candidate, Leader };
@@ -66,6 +74,21 @@ static std::string NodeRoleToStr(NodeRaftRoleEnum role) {
   }
 }
 
+/**
+ * @brief a client proposal waiting in the group commit queue
+ *
+ */
+struct ProposalReq {
+  std::string           payload;
+  eraftkv::EntryType    e_type;
+  eraftkv::CompressType compress_type;
+  int64_t               raw_size;
+  int64_t            log_index;
+  int64_t            log_term;
+  bool               is_success;
+  bool               done;
+};
+
 /**
  * @brief
  *
@@ -96,6 +119,67 @@ class RaftServer {
 
   void RunApply();
 
+  /**
+   * @brief apply the committed entries once if auto apply is open
+   *
+   */
+  void ApplyCommitted();
+
+  /**
+   * @brief hand commit notifications to an apply thread pool instead of
+   * the RunApply thread
+   *
+   * @param notifier
+   */
+  void SetApplyNotifier(std::function<void()> notifier);
+
+  /**
+   * @brief Get the raft group id
+   *
+   * @return int64_t
+   */
+  int64_t GetGroupId();
+
+  /**
+   * @brief directory of the sst files this group builds for a snapshot
+   *
+   * @return std::string
+   */
+  std::string SnapshotSendDir();
+
+  /**
+   * @brief directory of the sst files received for this group's snapshot
+   *
+   * @return std::string
+   */
+  std::string SnapshotRecvDir();
+
+  /**
+   * @brief whether committed entries are waiting to be applied
+   *
+   * @return true
+   * @return false
+   */
+  bool HasUnappliedEntries();
+
+  /**
+   * @brief heartbeat timer callback
+   *
+   */
+  void HeartbeatTimeout();
+
+  /**
+   * @brief election timer callback
+   *
+   */
+  void ElectionTimeout();
+
+  /**
+   * @brief wake the apply thread after the commit index advanced
+   *
+   */
+  void NotifyApply();
+
   /**
    * @brief
    *
@@ -103,6 +187,41 @@ class RaftServer {
    */
   EStatus ApplyEntries();
 
+  /**
+   * @brief release the cached log entries that are applied and, on the
+   * leader, matched by every live follower
+   *
+   */
+  void ReleaseLogCache();
+
+  /**
+   * @brief keep parsed copies of the entries just appended to the log
+   * until the commit index passes them, entries from the index of the first
+   * one on replace the kept ones
+   *
+   * @param etys
+   * @param move swap the entries in instead of copying them
+   */
+  void StageEntries(const std::vector<eraftkv::Entry*>& etys, bool move);
+
+  /**
+   * @brief hand the staged entries up to commit_idx to the apply thread,
+   * called before the commit index is advanced
+   *
+   * @param commit_idx
+   */
+  void QueueCommittedEntries(int64_t commit_idx);
+
+  /**
+   * @brief the committed entries after the applied index, taken from the
+   * committed entry queue, entries missing from it after a restart or an
+   * overflow are read from the log store. only called by the apply thread
+   *
+   * @param etys the entry objects already in etys are reused
+   * @return EStatus
+   */
+  EStatus TakeCommittedEntries(std::vector<eraftkv::Entry>* etys);
+
   /**
    * @brief
    *
@@ -137,9 +256,12 @@ class RaftServer {
                                  const eraftkv::AppendEntriesReq* req,
                                  eraftkv::AppendEntriesResp*      resp);
   /**
-   * @brief
+   * @brief handle an append entries response, called from the network
+   * completion thread, responses can arrive out of order. resp is nullptr when
+   * the rpc failed
    *
    * @param from_node
+   * @param req
    * @param resp
    * @return EStatus
    */
@@ -170,6 +292,18 @@ class RaftServer {
                              eraftkv::SnapshotReq*  req,
                              eraftkv::SnapshotResp* resp);
 
+  /**
+   * @brief serve a read index forwarded by a follower, the leader confirms
+   * its commit index with a heartbeat quorum but does not wait for its own
+   * state machine
+   *
+   * @param req
+   * @param resp
+   * @return EStatus
+   */
+  EStatus HandleReadIndexReq(const eraftkv::ReadIndexReq* req,
+                             eraftkv::ReadIndexResp*      resp);
+
   /**
    * @brief
    *
@@ -278,6 +412,37 @@ class RaftServer {
    */
   EStatus SendAppendEntries();
 
+  /**
+   * @brief
+   *
+   * @param node
+   * @return EStatus
+   */
+  EStatus SendAppendEntriesToNode(RaftNode* node);
+
+  /**
+   * @brief queue a snapshot for node, the caller holds raft_op_mutex_
+   *
+   * @param node
+   */
+  void ScheduleSnapshot(RaftNode* node);
+
+  /**
+   * @brief send the queued snapshots one at a time until the server is
+   * deleted
+   *
+   */
+  void RunSnapshotSender();
+
+  /**
+   * @brief build the sst files of the last checkpoint and send them with a
+   * snapshot req to node, runs outside raft_op_mutex_
+   *
+   * @param node
+   * @return EStatus
+   */
+  EStatus SendSnapshotToNode(RaftNode* node);
+
   /**
    * @brief
    *
@@ -288,6 +453,50 @@ class RaftServer {
    */
   bool IsUpToDate(int64_t last_idx, int64_t term);
 
+  /**
+   * @brief obtain a read index, from the local heartbeat quorum on the leader
+   * or from the leader on a follower, and wait until it is applied locally,
+   * reads issued after it returns kOk are linearizable
+   *
+   * @param read_index
+   * @return EStatus
+   */
+  EStatus ReadIndex(int64_t* read_index);
+
+  /**
+   * @brief confirm the leader's commit index with a heartbeat quorum
+   *
+   * @param read_index
+   * @param deadline
+   * @return EStatus
+   */
+  EStatus ConfirmLeaderReadIndex(
+      int64_t*                              read_index,
+      std::chrono::system_clock::time_point deadline);
+
+  /**
+   * @brief ask the current leader for its confirmed commit index
+   *
+   * @param read_index
+   * @return EStatus
+   */
+  EStatus ForwardReadIndex(int64_t* read_index);
+
+  /**
+   * @brief
+   *
+   * @return EStatus
+   */
+  EStatus UpdateReadIndexQuorum();
+
+  /**
+   * @brief true if a quorum acked a heartbeat sent within the lease duration
+   *
+   * @return true
+   * @return false
+   */
+  bool HasLeaderLease();
+
   /**
    * @brief
    *
@@ -327,6 +536,31 @@ class RaftServer {
                   int64_t*    new_log_term,
                   bool*       is_success);
 
+  /**
+   * @brief queue a proposal for group commit, return after the batch it
+   * joined is appended to the log
+   *
+   * @param payload
+   * @param e_type
+   * @param new_log_index
+   * @param new_log_term
+   * @param is_success
+   * @return EStatus
+   */
+  EStatus EnqueueProposal(std::string        payload,
+                          eraftkv::EntryType e_type,
+                          int64_t*           new_log_index,
+                          int64_t*           new_log_term,
+                          bool*              is_success);
+
+  /**
+   * @brief append a proposal batch with one log write and replicate it
+   *
+   * @param batch
+   * @return EStatus
+   */
+  EStatus CommitProposalBatch(const std::vector<ProposalReq*>& batch);
+
   /**
    * @brief Get the raft group Nodes
    *
@@ -428,18 +662,6 @@ class RaftServer {
    */
   long last_applied_term_;
 
-  /**
-   * @brief
-   *
-   */
-  int64_t heartbeat_tick_count_;
-
-  /**
-   * @brief
-   *
-   */
-  int64_t election_tick_count_;
-
   /**
    * @brief
    *
@@ -458,12 +680,6 @@ class RaftServer {
    */
   int64_t base_election_timeout_;
 
-  /**
-   * @brief current tick count
-   *
-   */
-  int64_t tick_count_;
-
   /**
    * @brief tick interval
    *
@@ -477,12 +693,12 @@ class RaftServer {
    */
   int64_t leader_id_;
   /**
-   * @brief
+   * @brief index of the last heartbeat round sent
    *
    */
   int64_t message_index_;
   /**
-   * @brief
+   * @brief highest heartbeat round acked by a quorum
    *
    */
   int64_t last_acked_message_index_;
@@ -510,6 +726,18 @@ class RaftServer {
    */
   int64_t max_entries_per_append_req_;
 
+  /**
+   * @brief entry byte budget of one append entries request
+   *
+   */
+  int64_t max_bytes_per_append_req_;
+
+  /**
+   * @brief max append entries requests in flight to one node
+   *
+   */
+  int64_t max_inflight_append_reqs_;
+
   /**
    * @brief
    *
@@ -534,8 +762,159 @@ class RaftServer {
    */
   bool is_snapshoting_;
 
+  /**
+   * @brief nodes waiting for snapshot_thread_ to send them a snapshot
+   *
+   */
+  std::deque<RaftNode*> snapshot_queue_;
+
+  std::mutex snapshot_mutex_;
+
+  std::condition_variable snapshot_cond_;
+
+  std::thread snapshot_thread_;
+
+  bool snapshot_running_;
+
   std::mutex raft_op_mutex_;
 
+  /**
+   * @brief entries read for an append entries request, kept to reuse their
+   * buffers, guarded by raft_op_mutex_
+   *
+   */
+  std::vector<eraftkv::Entry> append_etys_;
+
+  /**
+   * @brief proposals waiting for the next group commit batch
+   *
+   */
+  std::deque<ProposalReq*> propose_queue_;
+
+  /**
+   * @brief payload bytes in propose_queue_
+   *
+   */
+  int64_t propose_queue_bytes_;
+
+  /**
+   * @brief true while a caller is committing a proposal batch
+   *
+   */
+  bool propose_batch_running_;
+
+  /**
+   * @brief how long a batch leader waits for more proposals to join
+   *
+   */
+  int64_t propose_batch_window_us_;
+
+  /**
+   * @brief payload byte budget of one proposal batch
+   *
+   */
+  int64_t propose_batch_max_bytes_;
+
+  /**
+   * @brief codec of the normal entry payloads proposed by this node
+   *
+   */
+  eraftkv::CompressType log_compress_;
+
+  /**
+   * @brief entries of the proposal batch being committed, kept to reuse
+   * them across batches, only used by the caller holding
+   * propose_batch_running_
+   *
+   */
+  std::vector<eraftkv::Entry> propose_etys_;
+
+  std::vector<eraftkv::Entry*> propose_ety_ptrs_;
+
+  /**
+   * @brief appended entries above the commit index, in index order,
+   * guarded by staged_mutex_
+   *
+   */
+  std::deque<eraftkv::Entry> staged_etys_;
+
+  std::mutex staged_mutex_;
+
+  /**
+   * @brief committed entries on their way to the apply thread, pushed
+   * under staged_mutex_ and drained by TakeCommittedEntries
+   *
+   */
+  CommittedEntryQueue committed_queue_;
+
+  /**
+   * @brief entries TakeCommittedEntries read from the log store
+   *
+   */
+  std::vector<eraftkv::Entry> fallback_etys_;
+
+  std::mutex propose_mutex_;
+
+  std::condition_variable propose_cond_;
+
+  /**
+   * @brief a heartbeat round is sent and not yet acked by a quorum
+   *
+   */
+  bool read_index_round_inflight_;
+
+  std::mutex read_index_mutex_;
+
+  std::condition_variable read_index_cond_;
+
+  int64_t group_id_;
+
+  bool owns_net_;
+
+  /**
+   * @brief heartbeat and election deadlines of the core loop, may be shared
+   * by the raft groups of one process
+   *
+   */
+  TimerWheel* timer_wheel_;
+
+  bool owns_timer_wheel_;
+
+  int64_t election_timer_id_;
+
+  int64_t heartbeat_timer_id_;
+
+  std::mutex apply_mutex_;
+
+  std::condition_variable apply_cond_;
+
+  std::function<void()> apply_notifier_;
+
+  /**
+   * @brief (message index, send time ms) of recent heartbeat rounds
+   *
+   */
+  std::deque<std::pair<int64_t, int64_t>> heartbeat_send_times_;
+
+  /**
+   * @brief
+   *
+   */
+  ReadModeEnum read_mode_;
+
+  /**
+   * @brief max clock drift between nodes within one lease, the lease is
+   * shortened by it
+   *
+   */
+  int64_t clock_drift_bound_ms_;
+
+  /**
+   * @brief last time a follower accepted a message from the leader
+   *
+   */
+  int64_t last_leader_contact_ms_;
+
   /**
    * @brief
    *
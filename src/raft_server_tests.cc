@@ -0,0 +1,530 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file raft_server_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "raft_server.h"
+#include "rocksdb_storage_impl.h"
+#include "util.h"
+
+/**
+ * @brief queues the append entries requests of a leader, the test delivers
+ * them to the follower outside the leader's lock. requests may be queued by
+ * the timer and reader threads while the test delivers
+ *
+ */
+class QueueNetwork : public Network {
+ public:
+  struct PendingAppend {
+    RaftNode*                 target_node;
+    eraftkv::AppendEntriesReq req;
+  };
+
+  EStatus SendRequestVote(RaftServer*              raft,
+                          RaftNode*                target_node,
+                          eraftkv::RequestVoteReq* req) {
+    return EStatus::kOk;
+  }
+
+  EStatus SendAppendEntries(RaftServer*                raft,
+                            RaftNode*                  target_node,
+                            eraftkv::AppendEntriesReq* req) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->appends_.push_back({target_node, *req});
+    if (!req->is_heartbeat()) {
+      this->append_sizes_.push_back(req->entries_size());
+    }
+    return EStatus::kOk;
+  }
+
+  EStatus SendSnapshot(RaftServer*           raft,
+                       RaftNode*             target_node,
+                       eraftkv::SnapshotReq* req) {
+    this->snapshots_sent_ += 1;
+    return EStatus::kNotFound;
+  }
+
+  EStatus SendFile(RaftServer*        raft,
+                   RaftNode*          raft_node,
+                   const std::string& filename) {
+    return EStatus::kOk;
+  }
+
+  EStatus SendReadIndex(RaftServer*             raft,
+                        RaftNode*               target_node,
+                        eraftkv::ReadIndexReq*  req,
+                        eraftkv::ReadIndexResp* resp) {
+    if (this->read_index_leader_ == nullptr) {
+      return EStatus::kNotFound;
+    }
+    return this->read_index_leader_->HandleReadIndexReq(req, resp);
+  }
+
+  EStatus InitPeerNodeConnections(
+      std::map<int64_t, std::string> peers_address) {
+    return EStatus::kOk;
+  }
+
+  EStatus InsertPeerNodeConnection(int64_t peer_id, std::string addr) {
+    return EStatus::kOk;
+  }
+
+  /**
+   * @brief hand the queued requests to the follower and its responses back
+   * to the leader until nothing is left in flight
+   *
+   * @param leader
+   * @param follower
+   */
+  void Deliver(RaftServer* leader, RaftServer* follower) {
+    while (true) {
+      PendingAppend append;
+      {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->appends_.empty()) {
+          return;
+        }
+        append = this->appends_.front();
+        this->appends_.pop_front();
+      }
+      eraftkv::AppendEntriesResp resp;
+      follower->HandleAppendEntriesReq(nullptr, &append.req, &resp);
+      leader->HandleAppendEntriesResp(append.target_node, &append.req, &resp);
+    }
+  }
+
+  /**
+   * @brief serve the forwarded read index requests with leader
+   *
+   * @param leader
+   */
+  void SetReadIndexLeader(RaftServer* leader) {
+    this->read_index_leader_ = leader;
+  }
+
+  /**
+   * @brief the entry count of each append entries request sent so far
+   *
+   * @return std::vector<int>
+   */
+  std::vector<int> SentAppendSizes() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->append_sizes_;
+  }
+
+  int64_t SnapshotsSent() {
+    return this->snapshots_sent_;
+  }
+
+  /**
+   * @brief the number of queued heartbeats
+   *
+   * @return size_t
+   */
+  size_t PendingHeartbeats() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    size_t                      count = 0;
+    for (auto& append : this->appends_) {
+      if (append.req.is_heartbeat()) {
+        count += 1;
+      }
+    }
+    return count;
+  }
+
+ private:
+  std::deque<PendingAppend> appends_;
+
+  std::vector<int> append_sizes_;
+
+  std::mutex mutex_;
+
+  RaftServer* read_index_leader_ = nullptr;
+
+  std::atomic<int64_t> snapshots_sent_{0};
+};
+
+static RaftConfig NewTestRaftConfig(int64_t id) {
+  RaftConfig config;
+  config.id = id;
+  config.peer_address_map = {{0, "127.0.0.1:8088"}, {1, "127.0.0.1:8089"}};
+  config.snap_path = "/tmp/raft_test_snap_" + std::to_string(id);
+  config.owns_net = false;
+  return config;
+}
+
+static RaftServer* NewTestRaftServer(const RaftConfig& config, Network* net) {
+  auto log_store = new RocksDBSingleLogStorageImpl(
+      "/tmp/raft_test_log_" + std::to_string(config.id));
+  auto kv_store =
+      new RocksDBStorageImpl("/tmp/raft_test_kv_" + std::to_string(config.id));
+  return new RaftServer(config, log_store, kv_store, net);
+}
+
+static RaftServer* NewTestRaftServer(int64_t               id,
+                                     eraftkv::CompressType log_compress,
+                                     Network*              net) {
+  RaftConfig config = NewTestRaftConfig(id);
+  config.log_compress = log_compress;
+  return NewTestRaftServer(config, net);
+}
+
+static RaftNode* GetTestNode(RaftServer* raft, int64_t id) {
+  for (auto node : raft->GetNodes()) {
+    if (node->id == id) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+static void DeleteTestRaftServer(RaftServer* raft, int64_t id) {
+  delete raft;
+  DirectoryTool::DeleteDir("/tmp/raft_test_log_" + std::to_string(id));
+  DirectoryTool::DeleteDir("/tmp/raft_test_kv_" + std::to_string(id));
+  DirectoryTool::DeleteDir("/tmp/raft_test_snap_" + std::to_string(id));
+}
+
+TEST(RaftServerTest, ReplicateCompressedEntry) {
+  for (auto log_compress : {eraftkv::LZ4Compress, eraftkv::ZstdCompress}) {
+    QueueNetwork* net = new QueueNetwork();
+    RaftServer*   leader = NewTestRaftServer(0, log_compress, net);
+    RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+    leader->BecomeLeader();
+    net->Deliver(leader, follower);
+
+    eraftkv::KvOpPair op_pair;
+    op_pair.set_op_type(eraftkv::ClientOpType::Put);
+    op_pair.set_key("testkey");
+    op_pair.set_value(std::string(4096, 'v'));
+    int64_t log_index;
+    int64_t log_term;
+    bool    is_success;
+    ASSERT_EQ(leader->Propose(op_pair.SerializeAsString(),
+                              &log_index,
+                              &log_term,
+                              &is_success),
+              EStatus::kOk);
+    ASSERT_TRUE(is_success);
+    eraftkv::Entry ety;
+    ASSERT_EQ(leader->log_store_->Get(log_index, &ety), EStatus::kOk);
+    ASSERT_EQ(ety.compress_type(), log_compress);
+    net->Deliver(leader, follower);
+    // the next heartbeat carries the commit index to the follower
+    leader->SendHeartBeat();
+    net->Deliver(leader, follower);
+
+    ASSERT_EQ(follower->log_store_->Get(log_index, &ety), EStatus::kOk);
+    ASSERT_EQ(ety.compress_type(), log_compress);
+    ASSERT_EQ(follower->ApplyEntries(), EStatus::kOk);
+    ASSERT_FALSE(follower->HasUnappliedEntries());
+    ASSERT_EQ(follower->store_->GetKV("testkey").first, op_pair.value());
+
+    DeleteTestRaftServer(leader, 0);
+    DeleteTestRaftServer(follower, 1);
+    delete net;
+  }
+}
+
+TEST(RaftServerTest, ProposedEntriesSurviveRestart) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  leader->BecomeLeader();
+  int64_t log_index;
+  int64_t log_term;
+  bool    is_success;
+  ASSERT_EQ(leader->Propose("payload", &log_index, &log_term, &is_success),
+            EStatus::kOk);
+  ASSERT_TRUE(is_success);
+  // the leader counts its own entries toward the quorum once appended, the
+  // last index has to be on disk with them
+  delete leader;
+  leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  ASSERT_EQ(leader->log_store_->LastIndex(), log_index);
+  eraftkv::Entry ety;
+  ASSERT_EQ(leader->log_store_->Get(log_index, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.data(), "payload");
+  DeleteTestRaftServer(leader, 0);
+  delete net;
+}
+
+TEST(RaftServerTest, ReadIndexRefusedBeforeNoOpCommits) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  // the commit index of the last term may still grow until the no-op of
+  // this term commits
+  int64_t read_index;
+  ASSERT_EQ(leader->ReadIndex(&read_index), EStatus::kNotSupport);
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, ReadIndexWaitsForHeartbeatQuorum) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  net->Deliver(leader, follower);
+  ASSERT_EQ(leader->ApplyEntries(), EStatus::kOk);
+
+  int64_t read_index = -1;
+  auto    read = std::async(std::launch::async, [leader, &read_index] {
+    return leader->ReadIndex(&read_index);
+  });
+  // the round is not acked by the follower yet, one node is no quorum
+  ASSERT_EQ(read.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+  ASSERT_GT(net->PendingHeartbeats(), 0u);
+  while (read.wait_for(std::chrono::milliseconds(1)) !=
+         std::future_status::ready) {
+    net->Deliver(leader, follower);
+  }
+  ASSERT_EQ(read.get(), EStatus::kOk);
+  ASSERT_EQ(read_index, leader->log_store_->LastIndex());
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, FollowerReadWaitsForApply) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  net->SetReadIndexLeader(leader);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  net->Deliver(leader, follower);
+
+  eraftkv::KvOpPair op_pair;
+  op_pair.set_op_type(eraftkv::ClientOpType::Put);
+  op_pair.set_key("testkey");
+  op_pair.set_value("testval");
+  int64_t log_index;
+  int64_t log_term;
+  bool    is_success;
+  ASSERT_EQ(leader->Propose(op_pair.SerializeAsString(),
+                            &log_index,
+                            &log_term,
+                            &is_success),
+            EStatus::kOk);
+  ASSERT_TRUE(is_success);
+  net->Deliver(leader, follower);
+
+  // the follower asks the leader for the read index, the heartbeat round
+  // confirming it also carries the commit index to the follower
+  int64_t read_index = -1;
+  auto    read = std::async(std::launch::async, [follower, &read_index] {
+    return follower->ReadIndex(&read_index);
+  });
+  for (int i = 0; i < 20; i++) {
+    net->Deliver(leader, follower);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(read.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+  ASSERT_TRUE(follower->HasUnappliedEntries());
+  ASSERT_EQ(follower->ApplyEntries(), EStatus::kOk);
+  ASSERT_EQ(read.get(), EStatus::kOk);
+  ASSERT_EQ(read_index, log_index);
+  ASSERT_EQ(follower->store_->GetKV("testkey").first, "testval");
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, LeaderLeaseExpires) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftConfig    config = NewTestRaftConfig(0);
+  config.read_mode = ReadModeEnum::ReadOnlyLeaseBased;
+  // the lease lasts the 1000 ms election timeout less the drift bound
+  config.clock_drift_bound_ms = 800;
+  RaftServer* leader = NewTestRaftServer(config, net);
+  RaftServer* follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  ASSERT_FALSE(leader->HasLeaderLease());
+  net->Deliver(leader, follower);
+  ASSERT_TRUE(leader->HasLeaderLease());
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ASSERT_FALSE(leader->HasLeaderLease());
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, VoteRefusedWhileLeaderIsHeardFrom) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftConfig    config = NewTestRaftConfig(1);
+  config.read_mode = ReadModeEnum::ReadOnlyLeaseBased;
+  RaftServer* follower = NewTestRaftServer(config, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  net->Deliver(leader, follower);
+
+  // a candidate with a newer term and an up to date log would get the vote
+  // if the leader's lease was not still running
+  eraftkv::RequestVoteReq vote_req;
+  vote_req.set_term(2);
+  vote_req.set_candidtate_id(2);
+  vote_req.set_last_log_idx(follower->log_store_->LastIndex());
+  vote_req.set_last_log_term(follower->log_store_->LastTerm());
+  eraftkv::RequestVoteResp vote_resp;
+  ASSERT_EQ(follower->HandleRequestVoteReq(nullptr, &vote_req, &vote_resp),
+            EStatus::kOk);
+  ASSERT_FALSE(vote_resp.vote_granted());
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, ProbeMovesToReplicateOnMatch) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  RaftNode* node = GetTestNode(leader, 1);
+  ASSERT_EQ(node->progress_state, ProgressStateEnum::Probe);
+  ASSERT_EQ(node->inflight_append_reqs, 1);
+  net->Deliver(leader, follower);
+  ASSERT_EQ(node->progress_state, ProgressStateEnum::Replicate);
+  ASSERT_EQ(node->match_log_index, leader->log_store_->LastIndex());
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, AckRefillsAppendWindow) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  RaftServer*   follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  int64_t log_index;
+  int64_t log_term;
+  bool    is_success;
+  // the probe of the no-op is in flight, the entries wait behind it
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(leader->Propose("payload", &log_index, &log_term, &is_success),
+              EStatus::kOk);
+    ASSERT_TRUE(is_success);
+  }
+  net->Deliver(leader, follower);
+  ASSERT_EQ(follower->log_store_->LastIndex(), log_index);
+  ASSERT_EQ(GetTestNode(leader, 1)->match_log_index, log_index);
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
+
+TEST(RaftServerTest, FailedSnapshotMovesToProbe) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftServer*   leader = NewTestRaftServer(0, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  int64_t log_index;
+  int64_t log_term;
+  bool    is_success;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(leader->Propose("payload", &log_index, &log_term, &is_success),
+              EStatus::kOk);
+    ASSERT_TRUE(is_success);
+  }
+  ASSERT_EQ(leader->SnapshotingStart(log_index), EStatus::kOk);
+
+  // the node lost the reply of its probe and is behind the first log index
+  RaftNode* node = GetTestNode(leader, 1);
+  eraftkv::AppendEntriesReq req;
+  req.set_term(1);
+  req.set_prev_log_index(0);
+  ASSERT_EQ(leader->HandleAppendEntriesResp(node, &req, nullptr),
+            EStatus::kOk);
+  ASSERT_EQ(node->next_log_index, 1);
+  ASSERT_EQ(leader->SendAppendEntries(), EStatus::kOk);
+  for (int i = 0; i < 500 && net->SnapshotsSent() == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(net->SnapshotsSent(), 1);
+  // the sender thread moves the node back to probe once the send failed
+  for (int i = 0; i < 500 && node->progress_state != ProgressStateEnum::Probe;
+       i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(node->progress_state, ProgressStateEnum::Probe);
+  DeleteTestRaftServer(leader, 0);
+  delete net;
+}
+
+TEST(RaftServerTest, ByteBudgetSplitsAppendBatch) {
+  QueueNetwork* net = new QueueNetwork();
+  RaftConfig    config = NewTestRaftConfig(0);
+  // two of the proposed entries do not fit in one request
+  config.max_bytes_per_append = 150;
+  RaftServer* leader = NewTestRaftServer(config, net);
+  RaftServer* follower = NewTestRaftServer(1, eraftkv::NoCompress, net);
+  leader->BecomeCandidate();
+  leader->BecomeLeader();
+  int64_t log_index;
+  int64_t log_term;
+  bool    is_success;
+  // the probe of the no-op is in flight, the entries wait behind it
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(leader->Propose(std::string(100, 'v'),
+                              &log_index,
+                              &log_term,
+                              &is_success),
+              EStatus::kOk);
+    ASSERT_TRUE(is_success);
+  }
+  net->Deliver(leader, follower);
+  leader->SendHeartBeat();
+  net->Deliver(leader, follower);
+  ASSERT_EQ(follower->log_store_->LastIndex(), log_index);
+  // the no-op, then one request per entry
+  ASSERT_EQ(net->SentAppendSizes(), std::vector<int>({1, 1, 1, 1}));
+  DeleteTestRaftServer(leader, 0);
+  DeleteTestRaftServer(follower, 1);
+  delete net;
+}
@@ -36,11 +36,26 @@
 #include <rocksdb/utilities/checkpoint.h>
 #include <spdlog/spdlog.h>
 
+#include "compress_util.h"
 #include "consts.h"
 #include "eraftkv.pb.h"
 #include "eraftkv_server.h"
 #include "util.h"
 
+/**
+ * @brief db key buffer of PutKV, GetKV and DelKV, they are called from the
+ * rpc threads
+ *
+ */
+static thread_local std::string tls_key_buf;
+
+rocksdb::Slice RocksDBStorageImpl::UserKey(std::string_view key,
+                                           std::string*     buf) {
+  buf->assign("U:");
+  buf->append(key);
+  return rocksdb::Slice(*buf);
+}
+
 /**
  * @brief Get the Node Address object
  *
@@ -68,7 +83,8 @@ EStatus RocksDBStorageImpl::SaveNodeAddress(RaftServer* raft,
 }
 
 /**
- * @brief
+ * @brief apply the committed entries, the kv writes of the whole range go
+ * into one write batch with the applied index
  *
  * @param raft
  * @param snapshot_index
@@ -84,70 +100,88 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
   SPDLOG_INFO("appling entries from {} to {}",
               raft->last_applied_idx_,
               raft->commit_idx_);
-  auto etys =
-      raft->log_store_->Gets(raft->last_applied_idx_, raft->commit_idx_);
-  for (auto ety : etys) {
+  raft->TakeCommittedEntries(&this->apply_etys_);
+  int64_t applied_idx = raft->last_applied_idx_;
+  // entries before serial_end are too few normal entries in a row to pay
+  // for the worker hand off
+  size_t serial_end = 0;
+  for (size_t i = 0; i < this->apply_etys_.size(); i++) {
+    eraftkv::Entry* ety = &this->apply_etys_[i];
+    if (this->apply_pool_ != nullptr && i >= serial_end &&
+        ety->e_type() == eraftkv::EntryType::Normal) {
+      size_t end = i;
+      while (end < this->apply_etys_.size() &&
+             this->apply_etys_[end].e_type() == eraftkv::EntryType::Normal) {
+        end++;
+      }
+      serial_end = end;
+      if (end - i >= APPLY_PARALLEL_MIN_ENTRIES) {
+        // the pending writes may touch the keys of the run, they go first
+        if (this->WriteApplyBatch(raft, applied_idx) != EStatus::kOk ||
+            this->ApplyParallel(i, end) != EStatus::kOk) {
+          return EStatus::kError;
+        }
+        applied_idx = this->apply_etys_[end - 1].id();
+        if (this->WriteApplyBatch(raft, applied_idx) != EStatus::kOk) {
+          return EStatus::kError;
+        }
+        if (raft->log_store_->LogCount() > raft->snap_threshold_log_count_) {
+          raft->SnapshotingStart(applied_idx);
+        }
+        i = end - 1;
+        continue;
+      }
+    }
     switch (ety->e_type()) {
       case eraftkv::EntryType::Normal: {
-        eraftkv::KvOpPair* op_pair = new eraftkv::KvOpPair();
-        op_pair->ParseFromString(ety->data());
+        // payloads compressed by the leader are only inflated here
+        const std::string* data =
+            CompressUtil::EntryData(*ety, &this->apply_buf_);
+        applied_idx = ety->id();
+        if (data == nullptr) {
+          SPDLOG_ERROR("bad compressed payload of entry {}", ety->id());
+          break;
+        }
+        eraftkv::KvOpPair* op_pair = &this->apply_op_pair_;
+        op_pair->ParseFromString(*data);
         switch (op_pair->op_type()) {
           case eraftkv::ClientOpType::Put: {
-            if (PutKV(op_pair->key(), op_pair->value()) == EStatus::kOk) {
-              raft->log_store_->PersisLogMetaState(raft->commit_idx_,
-                                                   ety->id());
-              raft->last_applied_idx_ = ety->id();
-              if (raft->role_ == NodeRaftRoleEnum::Leader) {
-                {
-                  std::lock_guard<std::mutex> lg(ERaftKvServer::ready_mutex_);
-                  ERaftKvServer::is_ok_ = true;
-                  if (ERaftKvServer::ready_cond_vars_[op_pair->op_sign()] !=
-                      nullptr) {
-                    ERaftKvServer::ready_cond_vars_[op_pair->op_sign()]
-                        ->notify_one();
-                  }
-                }
-              }
-            }
+            this->apply_batch_.Put(
+                UserKey(op_pair->key(), &this->apply_key_buf_),
+                op_pair->value());
+            this->apply_op_signs_.push_back(op_pair->op_sign());
             break;
           }
           case eraftkv::ClientOpType::Del: {
-            if (DelKV(op_pair->key()) == EStatus::kOk) {
-              raft->log_store_->PersisLogMetaState(raft->commit_idx_,
-                                                   ety->id());
-              raft->last_applied_idx_ = ety->id();
-              if (raft->role_ == NodeRaftRoleEnum::Leader) {
-                {
-                  std::lock_guard<std::mutex> lg(ERaftKvServer::ready_mutex_);
-                  ERaftKvServer::is_ok_ = true;
-                  if (ERaftKvServer::ready_cond_vars_[op_pair->op_sign()] !=
-                      nullptr) {
-                    ERaftKvServer::ready_cond_vars_[op_pair->op_sign()]
-                        ->notify_one();
-                  }
-                }
-              }
-            }
+            this->apply_batch_.Delete(
+                UserKey(op_pair->key(), &this->apply_key_buf_));
+            this->apply_op_signs_.push_back(op_pair->op_sign());
             break;
           }
           default: {
-            raft->log_store_->PersisLogMetaState(raft->commit_idx_, ety->id());
-            raft->last_applied_idx_ = ety->id();
             break;
           }
         }
-        delete op_pair;
         if (raft->log_store_->LogCount() > raft->snap_threshold_log_count_) {
+          // the checkpoint has to hold everything up to the snapshot index
+          if (this->WriteApplyBatch(raft, applied_idx) != EStatus::kOk) {
+            return EStatus::kError;
+          }
           raft->SnapshotingStart(ety->id());
         }
         break;
       }
       case eraftkv::EntryType::ConfChange: {
-        eraftkv::ClusterConfigChangeReq* conf_change_req =
-            new eraftkv::ClusterConfigChangeReq();
+        // a conf change reads the shard groups written before it, and its
+        // proposer is woken right after it, so it is applied in a batch of
+        // its own
+        if (this->WriteApplyBatch(raft, applied_idx) != EStatus::kOk) {
+          return EStatus::kError;
+        }
+        applied_idx = ety->id();
+        eraftkv::ClusterConfigChangeReq  conf_change;
+        eraftkv::ClusterConfigChangeReq* conf_change_req = &conf_change;
         conf_change_req->ParseFromString(ety->data());
-        raft->log_store_->PersisLogMetaState(raft->commit_idx_, ety->id());
-        raft->last_applied_idx_ = ety->id();
         switch (conf_change_req->change_type()) {
           case eraftkv::ChangeType::ServerJoin: {
             if (conf_change_req->server().id() != raft->id_) {
@@ -160,7 +194,11 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
               raft->net_->InsertPeerNodeConnection(
                   conf_change_req->server().id(),
                   conf_change_req->server().address());
-              bool node_exist = false;
+              // the rpc threads walk the node list under raft_op_mutex_
+              // or read_index_mutex_
+              std::lock_guard<std::mutex> op_lock(raft->raft_op_mutex_);
+              std::lock_guard<std::mutex> read_lock(raft->read_index_mutex_);
+              bool                        node_exist = false;
               for (auto node : raft->nodes_) {
                 if (node->id == new_node->id) {
                   node_exist = true;
@@ -183,6 +221,7 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
           }
           case eraftkv::ChangeType::ServerLeave: {
             auto to_remove_serverid = conf_change_req->server().id();
+            std::lock_guard<std::mutex> lock(raft->raft_op_mutex_);
             for (auto iter = raft->nodes_.begin(); iter != raft->nodes_.end();
                  iter++) {
               if ((*iter)->id == to_remove_serverid &&
@@ -197,15 +236,14 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
             key.append(SG_META_PREFIX);
             key.append(std::to_string(conf_change_req->shard_id()));
             auto        sg = conf_change_req->shard_group();
-            std::string val = sg.SerializeAsString();
-            raft->store_->PutKV(key, val);
+            this->apply_batch_.Put("U:" + key, sg.SerializeAsString());
             break;
           }
           case eraftkv::ChangeType::ShardLeave: {
             std::string key;
             key.append(SG_META_PREFIX);
             key.append(std::to_string(conf_change_req->shard_id()));
-            raft->store_->DelKV(key);
+            this->apply_batch_.Delete("U:" + key);
             break;
           }
           case eraftkv::ChangeType::SlotMove: {
@@ -214,7 +252,8 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
             key.append(std::to_string(conf_change_req->shard_id()));
             auto value = raft->store_->GetKV(key);
             if (!value.first.empty()) {
-              eraftkv::ShardGroup* old_sg = new eraftkv::ShardGroup();
+              eraftkv::ShardGroup  old_shard_group;
+              eraftkv::ShardGroup* old_sg = &old_shard_group;
               old_sg->ParseFromString(value.first);
               // move slot to new sg
               if (sg.id() == old_sg->id()) {
@@ -233,9 +272,8 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
                   }
                 }
                 // write back to db
-                EStatus st =
-                    raft->store_->PutKV(key, old_sg->SerializeAsString());
-                assert(st == EStatus::kOk);
+                this->apply_batch_.Put("U:" + key,
+                                       old_sg->SerializeAsString());
               }
             }
             break;
@@ -247,6 +285,9 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
             break;
           }
         }
+        if (this->WriteApplyBatch(raft, applied_idx) != EStatus::kOk) {
+          return EStatus::kError;
+        }
         std::mutex map_mutex;
         {
           std::lock_guard<std::mutex> lg(map_mutex);
@@ -256,13 +297,124 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
                 ->notify_one();
           }
         }
-        delete conf_change_req;
+        break;
+      }
+      case eraftkv::EntryType::NoOp: {
+        applied_idx = ety->id();
         break;
       }
       default:
         break;
     }
   }
+  return this->WriteApplyBatch(raft, applied_idx);
+}
+
+EStatus RocksDBStorageImpl::WriteApplyBatch(RaftServer* raft,
+                                            int64_t     applied_idx) {
+  if (applied_idx == raft->last_applied_idx_ &&
+      this->apply_batch_.Count() == 0) {
+    return EStatus::kOk;
+  }
+  this->apply_batch_.Put("M:APPLIED_IDX", std::to_string(applied_idx));
+  rocksdb::WriteOptions write_options;
+  // the raft log is the wal of the kv db, after a crash the entries past
+  // the applied index that reached disk are applied again
+  write_options.disableWAL = true;
+  auto st = kv_db_->Write(write_options, &this->apply_batch_);
+  this->apply_batch_.Clear();
+  if (!st.ok()) {
+    SPDLOG_ERROR(
+        "write apply batch up to {} failed {}", applied_idx, st.ToString());
+    this->apply_op_signs_.clear();
+    return EStatus::kError;
+  }
+  raft->last_applied_idx_ = applied_idx;
+  if (raft->role_ == NodeRaftRoleEnum::Leader) {
+    std::lock_guard<std::mutex> lg(ERaftKvServer::ready_mutex_);
+    for (auto op_sign : this->apply_op_signs_) {
+      ERaftKvServer::is_ok_ = true;
+      if (ERaftKvServer::ready_cond_vars_[op_sign] != nullptr) {
+        ERaftKvServer::ready_cond_vars_[op_sign]->notify_one();
+      }
+    }
+  }
+  this->apply_op_signs_.clear();
+  return EStatus::kOk;
+}
+
+EStatus RocksDBStorageImpl::ApplyParallel(size_t begin, size_t end) {
+  int64_t workers = this->apply_pool_->WorkerCount();
+  size_t  count = end - begin;
+  if (this->parallel_ops_.size() < count) {
+    this->parallel_ops_.resize(count);
+  }
+  this->parallel_op_workers_.resize(count);
+  // decode the payloads of a contiguous share of the run on each worker and
+  // bucket the ops by the worker owning their key, then each worker writes
+  // its buckets of the shares in share order, so its keys stay in log order
+  this->apply_pool_->Run([this, begin, count, workers](int64_t w) {
+    size_t first = count * w / workers;
+    size_t last = count * (w + 1) / workers;
+    auto&  buckets = this->parallel_op_buckets_[w];
+    for (auto& bucket : buckets) {
+      bucket.clear();
+    }
+    for (size_t k = first; k < last; k++) {
+      const eraftkv::Entry& ety = this->apply_etys_[begin + k];
+      const std::string*    data =
+          CompressUtil::EntryData(ety, &this->parallel_bufs_[w]);
+      if (data == nullptr || !this->parallel_ops_[k].ParseFromString(*data)) {
+        this->parallel_op_workers_[k] = -1;
+        continue;
+      }
+      const std::string& key = this->parallel_ops_[k].key();
+      this->parallel_op_workers_[k] =
+          HashUtil::CRC64(0, key.data(), key.size()) % workers;
+      buckets[this->parallel_op_workers_[k]].push_back(k);
+    }
+  });
+  this->apply_pool_->Run([this, workers](int64_t w) {
+    rocksdb::WriteBatch* batch = &this->parallel_batches_[w];
+    std::string          key_buf;
+    for (int64_t d = 0; d < workers; d++) {
+      for (size_t k : this->parallel_op_buckets_[d][w]) {
+        const eraftkv::KvOpPair& op_pair = this->parallel_ops_[k];
+        if (op_pair.op_type() == eraftkv::ClientOpType::Put) {
+          batch->Put(UserKey(op_pair.key(), &key_buf), op_pair.value());
+        } else if (op_pair.op_type() == eraftkv::ClientOpType::Del) {
+          batch->Delete(UserKey(op_pair.key(), &key_buf));
+        }
+      }
+    }
+    this->parallel_status_[w] = rocksdb::Status::OK();
+    if (batch->Count() > 0) {
+      rocksdb::WriteOptions write_options;
+      write_options.disableWAL = true;
+      this->parallel_status_[w] = this->kv_db_->Write(write_options, batch);
+      batch->Clear();
+    }
+  });
+  for (int64_t w = 0; w < workers; w++) {
+    if (!this->parallel_status_[w].ok()) {
+      SPDLOG_ERROR("parallel apply of entries from {} failed {}",
+                   this->apply_etys_[begin].id(),
+                   this->parallel_status_[w].ToString());
+      return EStatus::kError;
+    }
+  }
+  for (size_t k = 0; k < count; k++) {
+    if (this->parallel_op_workers_[k] < 0) {
+      SPDLOG_ERROR("bad payload of entry {}",
+                   this->apply_etys_[begin + k].id());
+      continue;
+    }
+    auto op_type = this->parallel_ops_[k].op_type();
+    if (op_type == eraftkv::ClientOpType::Put ||
+        op_type == eraftkv::ClientOpType::Del) {
+      this->apply_op_signs_.push_back(this->parallel_ops_[k].op_sign());
+    }
+  }
   return EStatus::kOk;
 }
 
@@ -275,6 +427,13 @@ EStatus RocksDBStorageImpl::ApplyLog(RaftServer* raft,
 EStatus RocksDBStorageImpl::CreateCheckpoint(std::string snap_path) {
   rocksdb::Checkpoint* checkpoint;
   DirectoryTool::DeleteDir(snap_path);
+  // the applied writes skip the wal, they must be in sst files before the
+  // log entries they came from are erased
+  auto flush_st = this->kv_db_->Flush(rocksdb::FlushOptions());
+  if (!flush_st.ok()) {
+    SPDLOG_ERROR("flush kv db failed {}", flush_st.ToString());
+    return EStatus::kError;
+  }
   auto st = rocksdb::Checkpoint::Create(this->kv_db_, &checkpoint);
   if (!st.ok()) {
     return EStatus::kError;
@@ -344,6 +503,20 @@ EStatus RocksDBStorageImpl::ReadRaftMeta(RaftServer* raft,
 }
 
 
+EStatus RocksDBStorageImpl::ReadAppliedIdx(int64_t* applied_idx) {
+  std::string applied_idx_str;
+  auto        status =
+      kv_db_->Get(rocksdb::ReadOptions(), "M:APPLIED_IDX", &applied_idx_str);
+  if (status.IsNotFound()) {
+    return EStatus::kNotFound;
+  }
+  if (!status.ok()) {
+    return EStatus::kError;
+  }
+  *applied_idx = std::stoll(applied_idx_str);
+  return EStatus::kOk;
+}
+
 /**
  * @brief put key and value to kv rocksdb
  *
@@ -351,9 +524,12 @@ EStatus RocksDBStorageImpl::ReadRaftMeta(RaftServer* raft,
  * @param val
  * @return EStatus
  */
-EStatus RocksDBStorageImpl::PutKV(std::string key, std::string val) {
+EStatus RocksDBStorageImpl::PutKV(std::string_view key,
+                                  std::string_view val) {
   SPDLOG_INFO("put key {} value {} to db", key, val);
-  auto status = kv_db_->Put(rocksdb::WriteOptions(), "U:" + key, val);
+  auto status = kv_db_->Put(rocksdb::WriteOptions(),
+                            UserKey(key, &tls_key_buf),
+                            rocksdb::Slice(val.data(), val.size()));
   return status.ok() ? EStatus::kOk : EStatus::kPutKeyToRocksDBErr;
 }
 
@@ -363,13 +539,36 @@ EStatus RocksDBStorageImpl::PutKV(std::string key, std::string val) {
  * @param key
  * @return std::string
  */
-std::pair<std::string, bool> RocksDBStorageImpl::GetKV(std::string key) {
+std::pair<std::string, bool> RocksDBStorageImpl::GetKV(std::string_view key) {
   std::string value;
-  auto        status = kv_db_->Get(rocksdb::ReadOptions(), "U:" + key, &value);
+  auto        status = kv_db_->Get(
+      rocksdb::ReadOptions(), UserKey(key, &tls_key_buf), &value);
   return std::make_pair<std::string, bool>(std::move(value),
                                            !status.IsNotFound());
 }
 
+/**
+ * @brief get value from kv rocksdb, a value in the block cache is pinned
+ * instead of copied, a value in the memtable is copied once into the buffer
+ * value was built on
+ *
+ * @param key
+ * @param value
+ * @return EStatus
+ */
+EStatus RocksDBStorageImpl::GetKV(std::string_view        key,
+                                  rocksdb::PinnableSlice* value) {
+  value->Reset();
+  auto status = kv_db_->Get(rocksdb::ReadOptions(),
+                            kv_db_->DefaultColumnFamily(),
+                            UserKey(key, &tls_key_buf),
+                            value);
+  if (status.IsNotFound()) {
+    return EStatus::kNotFound;
+  }
+  return status.ok() ? EStatus::kOk : EStatus::kError;
+}
+
 /**
  * @brief
  *
@@ -418,9 +617,10 @@ EStatus RocksDBStorageImpl::IngestSST(std::string sst_file_path) {
  * @param key
  * @return EStatus
  */
-EStatus RocksDBStorageImpl::DelKV(std::string key) {
+EStatus RocksDBStorageImpl::DelKV(std::string_view key) {
   SPDLOG_DEBUG("del key {}", key);
-  auto status = kv_db_->Delete(rocksdb::WriteOptions(), "U:" + key);
+  auto status =
+      kv_db_->Delete(rocksdb::WriteOptions(), UserKey(key, &tls_key_buf));
   return status.ok() ? EStatus::kOk : EStatus::kDelFromRocksDBErr;
 }
 
@@ -428,12 +628,23 @@ EStatus RocksDBStorageImpl::DelKV(std::string key) {
  * @brief Construct a new RocksDB Storage Impl object
  *
  * @param db_path
+ * @param apply_workers
  */
-RocksDBStorageImpl::RocksDBStorageImpl(std::string db_path) {
+RocksDBStorageImpl::RocksDBStorageImpl(std::string db_path,
+                                       int64_t     apply_workers)
+    : apply_pool_(nullptr) {
   rocksdb::Options options;
   options.create_if_missing = true;
   rocksdb::Status status = rocksdb::DB::Open(options, db_path, &kv_db_);
   assert(status.ok());
+  if (apply_workers > 1) {
+    this->apply_pool_ = new ApplyWorkerPool(apply_workers);
+    this->parallel_bufs_.resize(apply_workers);
+    this->parallel_op_buckets_.resize(
+        apply_workers, std::vector<std::vector<size_t> >(apply_workers));
+    this->parallel_batches_.resize(apply_workers);
+    this->parallel_status_.resize(apply_workers);
+  }
 }
 
 /**
@@ -441,5 +652,6 @@ RocksDBStorageImpl::RocksDBStorageImpl(std::string db_path) {
  *
  */
 RocksDBStorageImpl::~RocksDBStorageImpl() {
+  delete this->apply_pool_;
   delete kv_db_;
 }
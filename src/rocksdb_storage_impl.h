@@ -34,8 +34,16 @@
 #pragma once
 
 #include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "apply_worker_pool.h"
 #include "log_entry_cache.h"
+#include "log_term_index.h"
 #include "raft_server.h"
 
 /**
@@ -98,6 +106,14 @@ class RocksDBStorageImpl : public Storage {
    */
   EStatus ReadRaftMeta(RaftServer* raft, int64_t* term, int64_t* vote);
 
+  /**
+   * @brief read the applied index written with the applied data
+   *
+   * @param applied_idx
+   * @return EStatus kNotFound if nothing was applied through a write batch
+   */
+  EStatus ReadAppliedIdx(int64_t* applied_idx);
+
   /**
    * @brief
    *
@@ -105,7 +121,7 @@ class RocksDBStorageImpl : public Storage {
    * @param val
    * @return EStatus
    */
-  EStatus PutKV(std::string key, std::string val);
+  EStatus PutKV(std::string_view key, std::string_view val);
 
   /**
    * @brief
@@ -113,7 +129,16 @@ class RocksDBStorageImpl : public Storage {
    * @param key
    * @return std::string
    */
-  std::pair<std::string, bool> GetKV(std::string key);
+  std::pair<std::string, bool> GetKV(std::string_view key);
+
+  /**
+   * @brief read the value of key pinned in the block cache or memtable
+   *
+   * @param key
+   * @param value
+   * @return EStatus
+   */
+  EStatus GetKV(std::string_view key, rocksdb::PinnableSlice* value);
 
   /**
    * @brief
@@ -142,14 +167,16 @@ class RocksDBStorageImpl : public Storage {
    * @param key
    * @return EStatus
    */
-  EStatus DelKV(std::string key);
+  EStatus DelKV(std::string_view key);
 
   /**
    * @brief Construct a new RocksDB Storage Impl object
    *
    * @param db_path
+   * @param apply_workers threads applying a long run of normal entries,
+   * split by key hash, 1 applies on the caller only
    */
-  RocksDBStorageImpl(std::string db_path);
+  RocksDBStorageImpl(std::string db_path, int64_t apply_workers = 1);
 
   /**
    * @brief Destroy the Rocks DB Storage Impl object
@@ -166,6 +193,16 @@ class RocksDBStorageImpl : public Storage {
   EStatus CreateCheckpoint(std::string snap_path);
 
  private:
+  /**
+   * @brief build the db key of a user key in buf, the capacity of buf is
+   * reused across calls
+   *
+   * @param key
+   * @param buf
+   * @return rocksdb::Slice
+   */
+  static rocksdb::Slice UserKey(std::string_view key, std::string* buf);
+
   /**
    * @brief
    *
@@ -177,6 +214,110 @@ class RocksDBStorageImpl : public Storage {
    *
    */
   rocksdb::DB* kv_db_;
+
+  /**
+   * @brief entries read by ApplyLog, kept to reuse their buffers
+   *
+   */
+  std::vector<eraftkv::Entry> apply_etys_;
+
+  /**
+   * @brief op of the normal entry being applied, reused across entries
+   *
+   */
+  eraftkv::KvOpPair apply_op_pair_;
+
+  /**
+   * @brief uncompressed payload of the entry being applied
+   *
+   */
+  std::string apply_buf_;
+
+  /**
+   * @brief db key of the entry being applied
+   *
+   */
+  std::string apply_key_buf_;
+
+  /**
+   * @brief the kv writes of the entries applied since the last
+   * WriteApplyBatch
+   *
+   */
+  rocksdb::WriteBatch apply_batch_;
+
+  /**
+   * @brief op signs of the client ops in apply_batch_, their proposers are
+   * woken once the batch is written
+   *
+   */
+  std::vector<int64_t> apply_op_signs_;
+
+  /**
+   * @brief write apply_batch_ with applied_idx in one batch without the kv
+   * wal, then move the applied index of raft to applied_idx
+   *
+   * @param raft
+   * @param applied_idx
+   * @return EStatus
+   */
+  EStatus WriteApplyBatch(RaftServer* raft, int64_t applied_idx);
+
+  /**
+   * @brief apply the normal entries apply_etys_[begin, end) on the worker
+   * pool, every key goes to the worker its hash picks, so the writes of one
+   * key keep the log order. the op signs are queued for the next
+   * WriteApplyBatch, which has to run before the applied index moves
+   *
+   * @param begin
+   * @param end
+   * @return EStatus
+   */
+  EStatus ApplyParallel(size_t begin, size_t end);
+
+  /**
+   * @brief workers of ApplyParallel, null with a single apply worker
+   *
+   */
+  ApplyWorkerPool* apply_pool_;
+
+  /**
+   * @brief ops parsed from the entries of an ApplyParallel run
+   *
+   */
+  std::vector<eraftkv::KvOpPair> parallel_ops_;
+
+  /**
+   * @brief worker owning the key of each op in parallel_ops_, -1 for an
+   * entry whose payload failed to decode
+   *
+   */
+  std::vector<int64_t> parallel_op_workers_;
+
+  /**
+   * @brief parallel_op_buckets_[d][w] holds the indices in parallel_ops_,
+   * in log order, that decode worker d hashed to write worker w
+   *
+   */
+  std::vector<std::vector<std::vector<size_t> > > parallel_op_buckets_;
+
+  /**
+   * @brief per worker uncompressed payload buffers
+   *
+   */
+  std::vector<std::string> parallel_bufs_;
+
+  /**
+   * @brief per worker write batches
+   *
+   */
+  std::vector<rocksdb::WriteBatch> parallel_batches_;
+
+  /**
+   * @brief per worker write results
+   *
+   */
+  std::vector<rocksdb::Status> parallel_status_;
 };
 
 
@@ -189,13 +330,95 @@ struct LogDBStatus {
   int64_t     db_size;
 };
 
+/**
+ * @brief a raft log rocksdb with the column families of its entries and of
+ * its meta state
+ *
+ */
+struct LogDb {
+  rocksdb::DB*                 db = nullptr;
+  rocksdb::ColumnFamilyHandle* entry_cf = nullptr;
+  rocksdb::ColumnFamilyHandle* meta_cf = nullptr;
+};
+
 class RocksDBSingleLogStorageImpl : public LogStore {
 
  public:
-  RocksDBSingleLogStorageImpl(std::string db_path);
+  /**
+   * @brief Construct a log storage owning the log db at db_path
+   *
+   * @param db_path
+   * @param entry_cf_options rocksdb options string tuning the entry column
+   * family, e.g. "write_buffer_size=134217728"
+   */
+  RocksDBSingleLogStorageImpl(std::string db_path,
+                              std::string entry_cf_options = "");
+
+  /**
+   * @brief Construct a log storage on a log db shared by several raft
+   * groups, the db is not owned
+   *
+   * @param log_db
+   * @param key_prefix
+   */
+  RocksDBSingleLogStorageImpl(LogDb log_db, std::string key_prefix);
 
   ~RocksDBSingleLogStorageImpl();
 
+  /**
+   * @brief open the log db at db_path with its entry and meta column
+   * families, log keys left in the default column family by an older
+   * version are moved into them
+   *
+   * @param db_path
+   * @param entry_cf_options
+   * @param log_db
+   * @return EStatus
+   */
+  static EStatus OpenLogDb(const std::string& db_path,
+                           const std::string& entry_cf_options,
+                           LogDb*             log_db);
+
+  /**
+   * @brief release the column family handles and close the db
+   *
+   * @param log_db
+   */
+  static void CloseLogDb(LogDb* log_db);
+
+  /**
+   * @brief db wide rocksdb options of a log db
+   *
+   * @return rocksdb::DBOptions
+   */
+  static rocksdb::DBOptions LogDbOptions();
+
+  /**
+   * @brief options of the entry column family, tuned for batched appends
+   * and bulk deletes from the head, sst files collecting many deletion
+   * tombstones are picked for compaction early
+   *
+   * @param entry_cf_options overrides in rocksdb options string format
+   * @return rocksdb::ColumnFamilyOptions
+   */
+  static rocksdb::ColumnFamilyOptions EntryCfOptions(
+      const std::string& entry_cf_options);
+
+  /**
+   * @brief options of the meta column family, a few small keys rewritten
+   * on every apply
+   *
+   * @return rocksdb::ColumnFamilyOptions
+   */
+  static rocksdb::ColumnFamilyOptions MetaCfOptions();
+
+  /**
+   * @brief hand the deletes of the entries erased by EraseBefore to a
+   * background thread, so log gc after a snapshot does not stall the caller
+   *
+   */
+  void StartBackgroundGc();
+
   /**
    * @brief Append add new entries
    *
@@ -204,6 +427,28 @@ class RocksDBSingleLogStorageImpl : public LogStore {
    */
   EStatus Append(eraftkv::Entry* ety);
 
+  /**
+   * @brief AppendBatch add a batch of new entries in one rocksdb write batch
+   * with a single sync
+   *
+   * @param etys
+   * @return EStatus
+   */
+  EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys);
+
+  /**
+   * @brief AppendBatch add a batch of new entries together with the log meta
+   * state in one rocksdb write batch with a single sync
+   *
+   * @param etys
+   * @param commit_idx
+   * @param applied_idx
+   * @return EStatus
+   */
+  EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys,
+                      int64_t                             commit_idx,
+                      int64_t                             applied_idx);
+
   /**
    * @brief
    *
@@ -237,26 +482,61 @@ class RocksDBSingleLogStorageImpl : public LogStore {
   EStatus EraseAfter(int64_t from_index);
 
   /**
-   * @brief Get get the given index entry
+   * @brief Get read the given index entry into ety, from the entry cache
+   * or the log db
    *
    * @param index
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus
    */
-  eraftkv::Entry* Get(int64_t index);
+  EStatus Get(int64_t index, eraftkv::Entry* ety);
 
   /**
    * @brief Get the First Ety object
    *
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus
    */
-  eraftkv::Entry* GetFirstEty();
+  EStatus GetFirstEty(eraftkv::Entry* ety);
 
   /**
    * @brief Get the Last Ety object
    *
-   * @return eraftkv::Entry*
+   * @param ety
+   * @return EStatus
+   */
+  EStatus GetLastEty(eraftkv::Entry* ety);
+
+  /**
+   * @brief Term get the term of the given index entry
+   *
+   * @param index
+   * @return int64_t
+   */
+  int64_t Term(int64_t index);
+
+  /**
+   * @brief LastTerm get the term of the last entry
+   *
+   * @return int64_t
+   */
+  int64_t LastTerm();
+
+  /**
+   * @brief FirstIndexOfTerm get the first index of the given term
+   *
+   * @param term
+   * @return int64_t
    */
-  eraftkv::Entry* GetLastEty();
+  int64_t FirstIndexOfTerm(int64_t term);
+
+  /**
+   * @brief LastIndexOfTerm get the last index of the given term
+   *
+   * @param term
+   * @return int64_t
+   */
+  int64_t LastIndexOfTerm(int64_t term);
 
   /**
    * @brief
@@ -268,13 +548,18 @@ class RocksDBSingleLogStorageImpl : public LogStore {
   EStatus EraseRange(int64_t start, int64_t end);
 
   /**
-   * @brief Gets get the given index range entry
+   * @brief Gets read the entries in [start_index, end_index] into entries
+   * with one batched multi get, the entry objects already in entries are
+   * reused
    *
    * @param start_index
    * @param end_index
-   * @return std::vector<eraftkv::Entry*>
+   * @param entries
+   * @return EStatus kNotFound if the range is cut short by a missing entry
    */
-  std::vector<eraftkv::Entry*> Gets(int64_t start_index, int64_t end_index);
+  EStatus Gets(int64_t                      start_index,
+               int64_t                      end_index,
+               std::vector<eraftkv::Entry>* entries);
 
   /**
    * @brief FirstIndex get the first index in the entry
@@ -292,6 +577,13 @@ class RocksDBSingleLogStorageImpl : public LogStore {
 
   EStatus Reinit();
 
+  /**
+   * @brief ReleaseCache drop the cached entries with id < index
+   *
+   * @param index
+   */
+  void ReleaseCache(int64_t index);
+
   /**
    * @brief LogCount get the number of entries
    *
@@ -314,6 +606,169 @@ class RocksDBSingleLogStorageImpl : public LogStore {
 
   int64_t applied_idx_;
 
+  /**
+   * @brief read the log meta, or write the initial entry of an empty log
+   *
+   */
+  void InitLogState();
+
+  /**
+   * @brief add the log meta state puts to batch
+   *
+   * @param batch
+   * @param commit_idx
+   * @param applied_idx
+   * @param last_index
+   */
+  void PutLogMetaState(rocksdb::WriteBatch* batch,
+                       int64_t              commit_idx,
+                       int64_t              applied_idx,
+                       int64_t              last_index);
+
+  /**
+   * @brief append the entries of etys that are not in the log yet, with the
+   * log meta state if with_meta is set, in one synced write batch
+   *
+   * @param etys
+   * @param with_meta
+   * @param commit_idx
+   * @param applied_idx
+   * @return EStatus
+   */
+  EStatus AppendEntries(const std::vector<eraftkv::Entry*>& etys,
+                        bool                                with_meta,
+                        int64_t                             commit_idx,
+                        int64_t                             applied_idx);
+
+  /**
+   * @brief load the term runs of [first_idx, last_idx] from the log db
+   *
+   */
+  void RebuildTermIndex();
+
+  /**
+   * @brief delete the entries in [start, end) with one write batch
+   *
+   * @param start
+   * @param end
+   * @param background run the batch on the gc thread if it is started
+   * @return EStatus
+   */
+  EStatus DeleteEntries(int64_t start, int64_t end, bool background);
+
+  /**
+   * @brief parse count entries from start_index into the first count
+   * entries with one bounded iterator scan, entry keys sort in index order
+   *
+   * @param start_index
+   * @param count
+   * @param entries cut at the first missing entry
+   * @return EStatus kNotFound if an entry in the range is missing
+   */
+  EStatus ScanEntries(int64_t                      start_index,
+                      size_t                       count,
+                      std::vector<eraftkv::Entry>* entries);
+
+  /**
+   * @brief rewrite the entry keys of an older key format to the current
+   * one and record LOG_KEY_FORMAT_VERSION in the log meta, each chunk is
+   * rewritten with one write batch so an interrupted migration resumes on
+   * the next open
+   *
+   * @return EStatus
+   */
+  EStatus MigrateEntryKeys();
+
+  /**
+   * @brief gc thread, writes the queued delete batches in order
+   *
+   */
+  void RunBackgroundGc();
+
+  /**
+   * @brief move the log keys an older version wrote to the default column
+   * family into the entry and meta column families, each chunk is moved
+   * with one write batch so an interrupted move resumes on the next open
+   *
+   * @param log_db
+   * @return EStatus
+   */
+  static EStatus MigrateDefaultColumnFamily(LogDb* log_db);
+
+  /**
+   * @brief add copies of the appended entries to the entry cache and evict
+   * the oldest ones beyond LOG_ENTRY_CACHE_MAX_MEM
+   *
+   * @param etys
+   */
+  void CacheEntries(const std::vector<eraftkv::Entry*>& etys);
+
+  /**
+   * @brief copy the cached entry with id = index into ety
+   *
+   * @param index
+   * @param ety
+   * @return bool false if the entry is not cached
+   */
+  bool GetCached(int64_t index, eraftkv::Entry* ety);
+
+  std::deque<rocksdb::WriteBatch*> gc_queue_;
+
+  std::mutex gc_mutex_;
+
+  std::condition_variable gc_cond_;
+
+  std::thread gc_thread_;
+
+  bool gc_running_;
+
+  /**
+   * @brief key_prefix_ + "I:" + big endian index, the keys of a log sort in
+   * index order
+   *
+   * @param index
+   * @return std::string
+   */
+  std::string EntryKey(int64_t index);
+
+  std::string MetaKey(const std::string& name);
+
+  /**
+   * @brief prefix of all the keys of this log in the log db
+   *
+   */
+  std::string key_prefix_;
+
+  bool owns_log_db_;
+
+  /**
+   * @brief term runs of the entries in the log db
+   *
+   */
+  LogTermIndex term_index_;
+
+  std::mutex term_index_mutex_;
+
+  /**
+   * @brief serialized copies of the hot tail of the log, from the last
+   * released index to the last appended entry
+   *
+   */
+  LogEntryCache entry_cache_;
+
+  std::mutex cache_mutex_;
 
   rocksdb::DB* log_db_;
+
+  /**
+   * @brief column family of the entries, keyed by EntryKey
+   *
+   */
+  rocksdb::ColumnFamilyHandle* entry_cf_;
+
+  /**
+   * @brief column family of the log meta state, keyed by MetaKey
+   *
+   */
+  rocksdb::ColumnFamilyHandle* meta_cf_;
 };
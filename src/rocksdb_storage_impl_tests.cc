@@ -33,9 +33,43 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+
+#include "consts.h"
 #include "rocksdb_storage_impl.h"
 #include "util.h"
 
+/**
+ * @brief entries 1 to n with data "val<i>", entry i is of term term_fn(i)
+ *
+ * @param n
+ * @param term_fn
+ * @return std::vector<eraftkv::Entry>
+ */
+static std::vector<eraftkv::Entry> MakeEntries(
+    int64_t                                n,
+    const std::function<int64_t(int64_t)>& term_fn = [](int64_t) {
+      return 1;
+    }) {
+  std::vector<eraftkv::Entry> etys(n);
+  for (int64_t i = 1; i <= n; i++) {
+    etys[i - 1].set_id(i);
+    etys[i - 1].set_term(term_fn(i));
+    etys[i - 1].set_data("val" + std::to_string(i));
+  }
+  return etys;
+}
+
+static std::vector<eraftkv::Entry*> EntryPtrs(
+    std::vector<eraftkv::Entry>* etys) {
+  std::vector<eraftkv::Entry*> ptrs;
+  for (auto& ety : *etys) {
+    ptrs.push_back(&ety);
+  }
+  return ptrs;
+}
+
 TEST(RockDBStorageImplTest, PutGet) {
   std::string         testk = "testkey";
   std::string         testv = "testval";
@@ -44,10 +78,325 @@ TEST(RockDBStorageImplTest, PutGet) {
   ASSERT_EQ(kv_store->PutKV(testk, testv), EStatus::kOk);
   ASSERT_EQ(kv_store->GetKV(testk).first, testv);
   ASSERT_EQ(kv_store->GetKV("").first, std::string(""));
+  // nothing was applied through an apply batch yet
+  int64_t applied_idx;
+  ASSERT_EQ(kv_store->ReadAppliedIdx(&applied_idx), EStatus::kNotFound);
   delete kv_store;
   DirectoryTool::DeleteDir("/tmp/testdb");
 }
 
+TEST(RockDBStorageImplTest, PinnedGet) {
+  RocksDBStorageImpl* kv_store = new RocksDBStorageImpl("/tmp/testdb");
+  std::string         big_val(1 << 20, 'v');
+  ASSERT_EQ(kv_store->PutKV("small", "val"), EStatus::kOk);
+  ASSERT_EQ(kv_store->PutKV("big", big_val), EStatus::kOk);
+  std::string            buf;
+  rocksdb::PinnableSlice val(&buf);
+  ASSERT_EQ(kv_store->GetKV("small", &val), EStatus::kOk);
+  ASSERT_EQ(val.ToString(), "val");
+  ASSERT_EQ(kv_store->GetKV("big", &val), EStatus::kOk);
+  ASSERT_EQ(val.size(), big_val.size());
+  ASSERT_EQ(val.ToString(), big_val);
+  ASSERT_EQ(kv_store->GetKV("not_exist", &val), EStatus::kNotFound);
+  // the pair read sees the same values
+  ASSERT_EQ(kv_store->GetKV("big").first, big_val);
+  ASSERT_EQ(kv_store->DelKV("big"), EStatus::kOk);
+  ASSERT_EQ(kv_store->GetKV("big", &val), EStatus::kNotFound);
+  delete kv_store;
+  DirectoryTool::DeleteDir("/tmp/testdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, AppendBatch) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys), EStatus::kOk);
+  ASSERT_EQ(log_store->LastIndex(), 10);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(7, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.term(), 1);
+  ASSERT_EQ(ety.data(), "val7");
+  std::vector<eraftkv::Entry> range;
+  ASSERT_EQ(log_store->Gets(3, 6, &range), EStatus::kOk);
+  ASSERT_EQ(range.size(), 4);
+  ASSERT_EQ(range[0].data(), "val3");
+  ASSERT_EQ(range[3].id(), 6);
+  // the range stops at the first missing entry
+  ASSERT_EQ(log_store->Gets(9, 12, &range), EStatus::kNotFound);
+  ASSERT_EQ(range.size(), 2);
+  ASSERT_EQ(range[1].data(), "val10");
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, AppendBatchWithMeta) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys, 5, 3), EStatus::kOk);
+  delete log_store;
+  // the meta written with the entries survives a restart
+  log_store = new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  int64_t commit_idx, applied_idx;
+  ASSERT_EQ(log_store->ReadMetaState(&commit_idx, &applied_idx), EStatus::kOk);
+  ASSERT_EQ(commit_idx, 5);
+  ASSERT_EQ(applied_idx, 3);
+  ASSERT_EQ(log_store->LastIndex(), 10);
+  ASSERT_EQ(log_store->LastTerm(), 1);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, AppendStaleBatch) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys, 5, 3), EStatus::kOk);
+  // a resent batch of entries already in the log keeps the tail
+  ASSERT_EQ(log_store->AppendBatch({etys[2], etys[3]}, 6, 3), EStatus::kOk);
+  ASSERT_EQ(log_store->LastIndex(), 10);
+  // a conflicting term truncates after the batch
+  eraftkv::Entry conflict;
+  conflict.set_id(7);
+  conflict.set_term(2);
+  ASSERT_EQ(log_store->AppendBatch({etys[5], &conflict}, 6, 3), EStatus::kOk);
+  ASSERT_EQ(log_store->LastIndex(), 7);
+  ASSERT_EQ(log_store->LastTerm(), 2);
+  delete log_store;
+  log_store = new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  ASSERT_EQ(log_store->LastIndex(), 7);
+  ASSERT_EQ(log_store->Term(6), 1);
+  ASSERT_EQ(log_store->Term(7), 2);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, EraseWithBackgroundGc) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  log_store->StartBackgroundGc();
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys), EStatus::kOk);
+  ASSERT_EQ(log_store->EraseBefore(6), EStatus::kOk);
+  ASSERT_EQ(log_store->FirstIndex(), 6);
+  ASSERT_EQ(log_store->EraseAfter(9), EStatus::kOk);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(9, &ety), EStatus::kNotFound);
+  ASSERT_EQ(ety.data(), "");
+  // the queued deletes are written before the store goes away
+  delete log_store;
+  log_store = new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  ASSERT_EQ(log_store->Get(3, &ety), EStatus::kNotFound);
+  ASSERT_EQ(log_store->Get(7, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.data(), "val7");
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, TermIndex) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  std::vector<eraftkv::Entry> etys =
+      MakeEntries(10, [](int64_t i) { return i <= 4 ? 1 : 2; });
+  for (auto& ety : etys) {
+    ASSERT_EQ(log_store->Append(&ety), EStatus::kOk);
+  }
+  ASSERT_EQ(log_store->Term(4), 1);
+  ASSERT_EQ(log_store->Term(5), 2);
+  ASSERT_EQ(log_store->LastTerm(), 2);
+  ASSERT_EQ(log_store->FirstIndexOfTerm(2), 5);
+  ASSERT_EQ(log_store->LastIndexOfTerm(1), 4);
+  ASSERT_EQ(log_store->PersisLogMetaState(0, 0), EStatus::kOk);
+  delete log_store;
+  // the term index is rebuilt from the log db on restart
+  log_store = new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  ASSERT_EQ(log_store->LastIndex(), 10);
+  ASSERT_EQ(log_store->Term(4), 1);
+  ASSERT_EQ(log_store->LastTerm(), 2);
+  ASSERT_EQ(log_store->LastIndexOfTerm(2), 10);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, SharedLogDb) {
+  LogDb log_db;
+  ASSERT_EQ(RocksDBSingleLogStorageImpl::OpenLogDb(
+                "/tmp/testlogdb", "", &log_db),
+            EStatus::kOk);
+  RocksDBSingleLogStorageImpl* log_store1 =
+      new RocksDBSingleLogStorageImpl(log_db, "G1/");
+  RocksDBSingleLogStorageImpl* log_store11 =
+      new RocksDBSingleLogStorageImpl(log_db, "G11/");
+  std::vector<eraftkv::Entry> ety_vals =
+      MakeEntries(10, [](int64_t i) { return i <= 5 ? 1 : 2; });
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store1->AppendBatch(etys), EStatus::kOk);
+  ASSERT_EQ(log_store1->LastIndex(), 10);
+  ASSERT_EQ(log_store11->LastIndex(), 0);
+  ASSERT_EQ(log_store1->Term(8), 2);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store11->Get(8, &ety), EStatus::kNotFound);
+  delete log_store1;
+  delete log_store11;
+  // the logs of the groups are reloaded from the shared db
+  log_store1 = new RocksDBSingleLogStorageImpl(log_db, "G1/");
+  ASSERT_EQ(log_store1->LastIndex(), 10);
+  ASSERT_EQ(log_store1->LastTerm(), 2);
+  delete log_store1;
+  RocksDBSingleLogStorageImpl::CloseLogDb(&log_db);
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, ColumnFamilies) {
+  RocksDBSingleLogStorageImpl* log_store = new RocksDBSingleLogStorageImpl(
+      "/tmp/testlogdb", "write_buffer_size=1048576");
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys, 10, 10), EStatus::kOk);
+  delete log_store;
+  std::vector<std::string> cf_names;
+  ASSERT_TRUE(rocksdb::DB::ListColumnFamilies(
+                  rocksdb::DBOptions(), "/tmp/testlogdb", &cf_names)
+                  .ok());
+  ASSERT_EQ(cf_names.size(), 3);
+  ASSERT_NE(std::find(cf_names.begin(), cf_names.end(), LOG_ENTRY_CF_NAME),
+            cf_names.end());
+  ASSERT_NE(std::find(cf_names.begin(), cf_names.end(), LOG_META_CF_NAME),
+            cf_names.end());
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, MigrateDefaultColumnFamily) {
+  // a log db written before the column family split keeps everything in
+  // the default column family
+  rocksdb::DB*     log_db;
+  rocksdb::Options options;
+  options.create_if_missing = true;
+  ASSERT_TRUE(rocksdb::DB::Open(options, "/tmp/testlogdb", &log_db).ok());
+  for (int64_t i = 0; i <= 5; i++) {
+    eraftkv::Entry ety;
+    ety.set_id(i);
+    ety.set_term(i == 0 ? 0 : 3);
+    ety.set_data("val" + std::to_string(i));
+    std::string key = "E:";
+    EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(i));
+    log_db->Put(rocksdb::WriteOptions(), key, ety.SerializeAsString());
+  }
+  log_db->Put(rocksdb::WriteOptions(), "M:COMMIT_IDX", "5");
+  log_db->Put(rocksdb::WriteOptions(), "M:APPLIED_IDX", "4");
+  log_db->Put(rocksdb::WriteOptions(), "M:FIRST_IDX", "0");
+  log_db->Put(rocksdb::WriteOptions(), "M:LAST_IDX", "5");
+  log_db->Put(rocksdb::WriteOptions(), "M:SNAP_IDX", "0");
+  delete log_db;
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  int64_t commit_idx, applied_idx;
+  ASSERT_EQ(log_store->ReadMetaState(&commit_idx, &applied_idx),
+            EStatus::kOk);
+  ASSERT_EQ(commit_idx, 5);
+  ASSERT_EQ(applied_idx, 4);
+  ASSERT_EQ(log_store->LastIndex(), 5);
+  ASSERT_EQ(log_store->LastTerm(), 3);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(4, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.data(), "val4");
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, MigrateEntryKeys) {
+  // format 1 entry keys hold the host endian index, index 256 sorts before
+  // index 1 with them
+  LogDb log_db;
+  ASSERT_EQ(RocksDBSingleLogStorageImpl::OpenLogDb(
+                "/tmp/testlogdb", "", &log_db),
+            EStatus::kOk);
+  for (int64_t i = 0; i <= 300; i++) {
+    eraftkv::Entry ety;
+    ety.set_id(i);
+    ety.set_term(i <= 200 ? 1 : 2);
+    ety.set_data("val" + std::to_string(i));
+    std::string key = "G1/E:";
+    EncodeDecodeTool::PutFixed64(&key, static_cast<uint64_t>(i));
+    log_db.db->Put(rocksdb::WriteOptions(),
+                   log_db.entry_cf,
+                   key,
+                   ety.SerializeAsString());
+  }
+  log_db.db->Put(
+      rocksdb::WriteOptions(), log_db.meta_cf, "G1/M:COMMIT_IDX", "300");
+  log_db.db->Put(
+      rocksdb::WriteOptions(), log_db.meta_cf, "G1/M:APPLIED_IDX", "300");
+  log_db.db->Put(
+      rocksdb::WriteOptions(), log_db.meta_cf, "G1/M:FIRST_IDX", "0");
+  log_db.db->Put(
+      rocksdb::WriteOptions(), log_db.meta_cf, "G1/M:LAST_IDX", "300");
+  log_db.db->Put(
+      rocksdb::WriteOptions(), log_db.meta_cf, "G1/M:SNAP_IDX", "0");
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl(log_db, "G1/");
+  ASSERT_EQ(log_store->LastIndex(), 300);
+  ASSERT_EQ(log_store->Term(200), 1);
+  ASSERT_EQ(log_store->Term(201), 2);
+  std::vector<eraftkv::Entry> range;
+  ASSERT_EQ(log_store->Gets(250, 260, &range), EStatus::kOk);
+  ASSERT_EQ(range.size(), 11);
+  ASSERT_EQ(range[6].data(), "val256");
+  // the range delete of [0, 256) leaves 256 and later in place
+  ASSERT_EQ(log_store->EraseBefore(256), EStatus::kOk);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(255, &ety), EStatus::kNotFound);
+  ASSERT_EQ(log_store->Get(256, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.data(), "val256");
+  delete log_store;
+  std::string format;
+  ASSERT_TRUE(log_db.db
+                  ->Get(rocksdb::ReadOptions(),
+                        log_db.meta_cf,
+                        "G1/M:KEY_FORMAT",
+                        &format)
+                  .ok());
+  ASSERT_EQ(format, std::to_string(LOG_KEY_FORMAT_VERSION));
+  RocksDBSingleLogStorageImpl::CloseLogDb(&log_db);
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
+TEST(RocksDBSingleLogStorageImplTest, EntryCache) {
+  RocksDBSingleLogStorageImpl* log_store =
+      new RocksDBSingleLogStorageImpl("/tmp/testlogdb");
+  std::vector<eraftkv::Entry>  ety_vals = MakeEntries(10);
+  std::vector<eraftkv::Entry*> etys = EntryPtrs(&ety_vals);
+  ASSERT_EQ(log_store->AppendBatch(etys), EStatus::kOk);
+  // released entries are read back from the log db
+  log_store->ReleaseCache(6);
+  std::vector<eraftkv::Entry> range;
+  ASSERT_EQ(log_store->Gets(4, 10, &range), EStatus::kOk);
+  ASSERT_EQ(range.size(), 7);
+  ASSERT_EQ(range[0].data(), "val4");
+  ASSERT_EQ(range[6].data(), "val10");
+  // a conflicting append replaces the cached tail
+  ASSERT_EQ(log_store->EraseAfter(8), EStatus::kOk);
+  for (int64_t i = 8; i <= 10; i++) {
+    etys[i - 1]->set_term(2);
+    etys[i - 1]->set_data("new" + std::to_string(i));
+  }
+  ASSERT_EQ(log_store->AppendBatch({etys[7], etys[8], etys[9]}),
+            EStatus::kOk);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->GetLastEty(&ety), EStatus::kOk);
+  ASSERT_EQ(ety.term(), 2);
+  ASSERT_EQ(ety.data(), "new10");
+  ASSERT_EQ(log_store->Gets(7, 9, &range), EStatus::kOk);
+  ASSERT_EQ(range[0].data(), "val7");
+  ASSERT_EQ(range[1].data(), "new8");
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testlogdb");
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,764 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file segment_log_storage_impl.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "segment_log_storage_impl.h"
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "util.h"
+
+#define SEGMENT_LOG_RECORD_HEADER_SIZE 13
+
+#define SEGMENT_LOG_META_SIZE (4 * sizeof(uint64_t))
+
+/**
+ * @brief sequential reader of the records of a segment, reads the file in
+ * SEGMENT_LOG_READ_AHEAD chunks
+ *
+ */
+class SegmentRecordReader {
+ public:
+  SegmentRecordReader(int fd, int64_t offset, int64_t end)
+      : fd_(fd), offset_(offset), end_(end), buf_offset_(offset) {}
+
+  /**
+   * @brief read the next record
+   *
+   * @param type
+   * @param data
+   * @param len
+   * @return false at the end of the written records or on a torn or
+   * corrupted record
+   */
+  bool Next(uint8_t* type, const char** data, uint32_t* len) {
+    if (!this->Fill(SEGMENT_LOG_RECORD_HEADER_SIZE)) {
+      return false;
+    }
+    const char* p = this->buf_.data() + (this->offset_ - this->buf_offset_);
+    // len counts the type byte, so it is never zero for a written record
+    uint32_t record_len =
+        EncodeDecodeTool::DecodeFixed32(reinterpret_cast<const uint8_t*>(p));
+    if (record_len == 0) {
+      return false;
+    }
+    *len = record_len - 1;
+    *type = static_cast<uint8_t>(p[4]);
+    uint64_t crc = EncodeDecodeTool::DecodeFixed64(
+        reinterpret_cast<const uint8_t*>(p + 5));
+    if (!this->Fill(SEGMENT_LOG_RECORD_HEADER_SIZE + *len)) {
+      return false;
+    }
+    p = this->buf_.data() + (this->offset_ - this->buf_offset_);
+    *data = p + SEGMENT_LOG_RECORD_HEADER_SIZE;
+    uint64_t actual = HashUtil::CRC64(0, p + 4, 1);
+    actual = HashUtil::CRC64(actual, *data, *len);
+    if (actual != crc) {
+      return false;
+    }
+    this->record_offset_ = this->offset_;
+    this->offset_ += SEGMENT_LOG_RECORD_HEADER_SIZE + *len;
+    return true;
+  }
+
+  /**
+   * @brief file offset of the record returned by the last Next
+   *
+   * @return int64_t
+   */
+  int64_t RecordOffset() {
+    return this->record_offset_;
+  }
+
+  /**
+   * @brief file offset after the record returned by the last Next
+   *
+   * @return int64_t
+   */
+  int64_t Offset() {
+    return this->offset_;
+  }
+
+ private:
+  bool Fill(int64_t need) {
+    if (this->offset_ + need <=
+        this->buf_offset_ + static_cast<int64_t>(this->buf_.size())) {
+      return true;
+    }
+    if (this->offset_ + need > this->end_) {
+      return false;
+    }
+    int64_t read_size = std::min<int64_t>(
+        std::max<int64_t>(need, SEGMENT_LOG_READ_AHEAD),
+        this->end_ - this->offset_);
+    this->buf_.resize(read_size);
+    ssize_t n = pread(this->fd_, &this->buf_[0], read_size, this->offset_);
+    this->buf_offset_ = this->offset_;
+    if (n < need) {
+      this->buf_.clear();
+      return false;
+    }
+    this->buf_.resize(n);
+    return true;
+  }
+
+  int fd_;
+
+  int64_t offset_;
+
+  int64_t end_;
+
+  std::string buf_;
+
+  int64_t buf_offset_;
+
+  int64_t record_offset_ = -1;
+};
+
+static void EncodeRecord(std::string*       buf,
+                         uint8_t            type,
+                         const std::string& payload) {
+  char     type_byte = static_cast<char>(type);
+  uint64_t crc = HashUtil::CRC64(0, &type_byte, 1);
+  crc = HashUtil::CRC64(crc, payload.data(), payload.size());
+  EncodeDecodeTool::PutFixed32(buf,
+                               static_cast<uint32_t>(payload.size() + 1));
+  buf->push_back(type_byte);
+  EncodeDecodeTool::PutFixed64(buf, crc);
+  buf->append(payload);
+}
+
+static bool WriteFully(int fd, const std::string& buf, int64_t offset) {
+  size_t written = 0;
+  while (written < buf.size()) {
+    ssize_t n = pwrite(
+        fd, buf.data() + written, buf.size() - written, offset + written);
+    if (n <= 0) {
+      return false;
+    }
+    written += n;
+  }
+  return true;
+}
+
+SegmentLogStorageImpl::SegmentLogStorageImpl(std::string dir_path,
+                                             int64_t     segment_size)
+    : dir_path_(dir_path)
+    , segment_size_(segment_size)
+    , first_idx_(0)
+    , last_idx_(-1)
+    , commit_idx_(0)
+    , applied_idx_(0)
+    , has_meta_(false) {
+  DirectoryTool::MkDir(dir_path_);
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->Recover();
+  if (this->last_idx_ == -1) {
+    // a new log starts with an empty entry 0 like the rocksdb log
+    eraftkv::Entry ety;
+    this->first_idx_ = 0;
+    this->AppendRecords({&ety}, false, true);
+  }
+  SPDLOG_INFO("open segment log {} with {} segments, entries [{}, {}]",
+              dir_path_,
+              this->segments_.size(),
+              this->first_idx_,
+              this->last_idx_);
+}
+
+SegmentLogStorageImpl::~SegmentLogStorageImpl() {
+  for (auto it : this->segments_) {
+    close(it.second->fd);
+    delete it.second;
+  }
+}
+
+EStatus SegmentLogStorageImpl::Recover() {
+  for (auto path : DirectoryTool::ListDirFiles(this->dir_path_)) {
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    if (name.compare(0, 4, "log_") != 0) {
+      continue;
+    }
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+      SPDLOG_ERROR("open log segment {} failed", path);
+      return EStatus::kError;
+    }
+    LogSegment* segment = new LogSegment();
+    segment->seq = std::stoll(name.substr(4));
+    segment->path = path;
+    segment->fd = fd;
+    this->segments_[segment->seq] = segment;
+  }
+  int64_t meta_first_term = -1;
+  int64_t first_entry_idx = -1;
+  for (auto it : this->segments_) {
+    this->LoadSegment(it.second, &meta_first_term);
+    if (first_entry_idx == -1 && it.second->first_index != -1) {
+      first_entry_idx = it.second->first_index;
+    }
+    if (it.second->last_index != -1) {
+      this->last_idx_ = it.second->last_index;
+    }
+  }
+  if (this->last_idx_ == -1) {
+    this->term_index_.Clear();
+    return EStatus::kOk;
+  }
+  int64_t meta_first_idx = this->first_idx_;
+  if (!this->has_meta_ || this->first_idx_ < first_entry_idx) {
+    this->first_idx_ = first_entry_idx;
+  }
+  this->term_index_.CompactTo(this->first_idx_);
+  if (this->has_meta_ && meta_first_idx == this->first_idx_ &&
+      meta_first_term >= 0) {
+    this->term_index_.ResetFirst(this->first_idx_, meta_first_term);
+  }
+  return EStatus::kOk;
+}
+
+void SegmentLogStorageImpl::LoadSegment(LogSegment* segment,
+                                        int64_t*    meta_first_term) {
+  struct stat st;
+  fstat(segment->fd, &st);
+  segment->first_index = -1;
+  segment->last_index = -1;
+  segment->sparse_offsets.clear();
+  SegmentRecordReader reader(segment->fd, 0, st.st_size);
+  uint8_t             type;
+  const char*         data;
+  uint32_t            len;
+  eraftkv::Entry      ety;
+  int64_t             end_offset = 0;
+  while (reader.Next(&type, &data, &len)) {
+    if (type == SEGMENT_LOG_META_RECORD && len == SEGMENT_LOG_META_SIZE) {
+      auto p = reinterpret_cast<const uint8_t*>(data);
+      this->commit_idx_ = EncodeDecodeTool::DecodeFixed64(p);
+      this->applied_idx_ = EncodeDecodeTool::DecodeFixed64(p + 8);
+      this->first_idx_ = EncodeDecodeTool::DecodeFixed64(p + 16);
+      *meta_first_term = EncodeDecodeTool::DecodeFixed64(p + 24);
+      this->has_meta_ = true;
+      end_offset = reader.Offset();
+      continue;
+    }
+    if (type != SEGMENT_LOG_ENTRY_RECORD || !ety.ParseFromArray(data, len)) {
+      break;
+    }
+    // entries in a segment are consecutive, anything else is a stale tail
+    if (segment->first_index == -1) {
+      segment->first_index = ety.id();
+    } else if (ety.id() != segment->last_index + 1) {
+      break;
+    }
+    if ((ety.id() - segment->first_index) % SEGMENT_LOG_INDEX_INTERVAL == 0) {
+      segment->sparse_offsets.push_back(reader.RecordOffset());
+    }
+    segment->last_index = ety.id();
+    this->term_index_.Append(ety.id(), ety.term());
+    end_offset = reader.Offset();
+  }
+  segment->write_offset = end_offset;
+}
+
+LogSegment* SegmentLogStorageImpl::NewSegment() {
+  int64_t seq =
+      this->segments_.empty() ? 0 : this->segments_.rbegin()->first + 1;
+  char    name[32];
+  snprintf(name, sizeof(name), "log_%020ld", static_cast<long>(seq));
+  std::string path = this->dir_path_ + "/" + name;
+  int         fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    SPDLOG_ERROR("create log segment {} failed", path);
+    return nullptr;
+  }
+  // zero filled preallocation, the first zero length header ends the
+  // written records
+  posix_fallocate(fd, 0, this->segment_size_);
+  int dir_fd = open(this->dir_path_.c_str(), O_RDONLY);
+  if (dir_fd >= 0) {
+    fsync(dir_fd);
+    close(dir_fd);
+  }
+  LogSegment* segment = new LogSegment();
+  segment->seq = seq;
+  segment->path = path;
+  segment->fd = fd;
+  segment->write_offset = 0;
+  segment->first_index = -1;
+  segment->last_index = -1;
+  this->segments_[seq] = segment;
+  return segment;
+}
+
+void SegmentLogStorageImpl::DropSegment(LogSegment* segment) {
+  close(segment->fd);
+  unlink(segment->path.c_str());
+  this->segments_.erase(segment->seq);
+  delete segment;
+}
+
+std::string SegmentLogStorageImpl::EncodeMeta() {
+  std::string meta;
+  EncodeDecodeTool::PutFixed64(&meta, this->commit_idx_);
+  EncodeDecodeTool::PutFixed64(&meta, this->applied_idx_);
+  EncodeDecodeTool::PutFixed64(&meta, this->first_idx_);
+  EncodeDecodeTool::PutFixed64(&meta, this->term_index_.Term(this->first_idx_));
+  return meta;
+}
+
+/**
+ * @brief the records of a call are written with one pwrite per segment,
+ * a new segment starts with a meta record so the last meta record is
+ * always in the active segment. entries the log already holds with the same
+ * term are skipped, the log is only truncated at a conflicting term
+ *
+ * @param etys
+ * @param with_meta
+ * @param sync
+ * @return EStatus
+ */
+EStatus SegmentLogStorageImpl::AppendRecords(
+    const std::vector<eraftkv::Entry*>& etys,
+    bool                                with_meta,
+    bool                                sync) {
+  LogSegment* segment =
+      this->segments_.empty() ? nullptr : this->segments_.rbegin()->second;
+  std::string buf;
+  std::string payload;
+  bool        ok = true;
+  auto        flush = [&]() {
+    if (segment != nullptr && !buf.empty()) {
+      ok = ok && WriteFully(segment->fd, buf, segment->write_offset);
+      segment->write_offset += buf.size();
+      buf.clear();
+    }
+    if (segment != nullptr && sync) {
+      ok = ok && fdatasync(segment->fd) == 0;
+    }
+  };
+  auto roll = [&]() {
+    flush();
+    segment = this->NewSegment();
+    if (segment == nullptr) {
+      return false;
+    }
+    EncodeRecord(&buf, SEGMENT_LOG_META_RECORD, this->EncodeMeta());
+    return true;
+  };
+  if (segment == nullptr && !roll()) {
+    return EStatus::kError;
+  }
+  // the meta record closing the call has to fit in the segment as well
+  int64_t meta_record_size =
+      SEGMENT_LOG_RECORD_HEADER_SIZE + SEGMENT_LOG_META_SIZE;
+  int64_t tail_size = with_meta ? meta_record_size : 0;
+  for (auto ety : etys) {
+    if (ety->id() < this->first_idx_ ||
+        (ety->id() <= this->last_idx_ &&
+         this->term_index_.Term(ety->id()) == ety->term())) {
+      continue;
+    }
+    if (ety->id() <= this->last_idx_) {
+      // overwriting entries of another term truncates the log first
+      flush();
+      if (this->TruncateAfter(ety->id() - 1) != EStatus::kOk) {
+        return EStatus::kError;
+      }
+      segment = this->segments_.rbegin()->second;
+    }
+    ety->SerializeToString(&payload);
+    int64_t offset = segment->write_offset + buf.size();
+    bool    gap = segment->last_index != -1 &&
+               ety->id() != segment->last_index + 1;
+    bool    full = offset > 0 && offset + SEGMENT_LOG_RECORD_HEADER_SIZE +
+                                         payload.size() + tail_size >
+                                     this->segment_size_;
+    if (gap || full) {
+      if (!roll()) {
+        return EStatus::kError;
+      }
+      offset = segment->write_offset + buf.size();
+    }
+    if (segment->first_index == -1) {
+      segment->first_index = ety->id();
+    }
+    if ((ety->id() - segment->first_index) % SEGMENT_LOG_INDEX_INTERVAL == 0) {
+      segment->sparse_offsets.push_back(offset);
+    }
+    segment->last_index = ety->id();
+    EncodeRecord(&buf, SEGMENT_LOG_ENTRY_RECORD, payload);
+    this->last_idx_ = ety->id();
+    this->term_index_.Append(ety->id(), ety->term());
+  }
+  if (with_meta) {
+    // a new segment starts with the meta record
+    if (segment->write_offset + static_cast<int64_t>(buf.size()) +
+            meta_record_size >
+        this->segment_size_) {
+      if (!roll()) {
+        return EStatus::kError;
+      }
+    } else {
+      EncodeRecord(&buf, SEGMENT_LOG_META_RECORD, this->EncodeMeta());
+    }
+  }
+  flush();
+  if (!ok) {
+    SPDLOG_ERROR("write log segment {} failed", segment->path);
+    return EStatus::kError;
+  }
+  return EStatus::kOk;
+}
+
+EStatus SegmentLogStorageImpl::AppendMeta(bool sync) {
+  return this->AppendRecords({}, true, sync);
+}
+
+/**
+ * @brief segments starting after index are deleted, the segment holding
+ * index is rewound to the record after it, the stale tail is zeroed so a
+ * recovery never reads it back
+ *
+ * @param index
+ * @return EStatus
+ */
+EStatus SegmentLogStorageImpl::TruncateAfter(int64_t index) {
+  while (!this->segments_.empty()) {
+    LogSegment* segment = this->segments_.rbegin()->second;
+    if (segment->first_index != -1 && segment->first_index <= index) {
+      break;
+    }
+    this->DropSegment(segment);
+  }
+  if (!this->segments_.empty()) {
+    LogSegment* segment = this->segments_.rbegin()->second;
+    if (segment->last_index > index) {
+      int64_t slot =
+          (index + 1 - segment->first_index) / SEGMENT_LOG_INDEX_INTERVAL;
+      SegmentRecordReader reader(
+          segment->fd, segment->sparse_offsets[slot], segment->write_offset);
+      uint8_t        type;
+      const char*    data;
+      uint32_t       len;
+      eraftkv::Entry ety;
+      int64_t        rewind_offset = -1;
+      while (reader.Next(&type, &data, &len)) {
+        if (type == SEGMENT_LOG_ENTRY_RECORD &&
+            ety.ParseFromArray(data, len) && ety.id() == index + 1) {
+          rewind_offset = reader.RecordOffset();
+          break;
+        }
+      }
+      if (rewind_offset == -1) {
+        SPDLOG_ERROR("entry {} not found in log segment {}",
+                     index + 1,
+                     segment->path);
+        return EStatus::kError;
+      }
+      std::string zeros(segment->write_offset - rewind_offset, '\0');
+      if (!WriteFully(segment->fd, zeros, rewind_offset) ||
+          fdatasync(segment->fd) != 0) {
+        return EStatus::kError;
+      }
+      segment->write_offset = rewind_offset;
+      segment->last_index = index;
+      segment->sparse_offsets.resize(slot + (rewind_offset >
+                                             segment->sparse_offsets[slot]));
+    }
+  }
+  if (this->segments_.empty() && this->NewSegment() == nullptr) {
+    return EStatus::kError;
+  }
+  this->last_idx_ = index;
+  this->term_index_.TruncateFrom(index + 1);
+  // the last meta record may have been in the dropped tail
+  return this->AppendMeta(true);
+}
+
+EStatus SegmentLogStorageImpl::Reinit() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  while (!this->segments_.empty()) {
+    this->DropSegment(this->segments_.begin()->second);
+  }
+  this->term_index_.Clear();
+  if (this->NewSegment() == nullptr) {
+    return EStatus::kError;
+  }
+  return this->AppendMeta(true);
+}
+
+EStatus SegmentLogStorageImpl::Append(eraftkv::Entry* ety) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->AppendRecords({ety}, false, false);
+}
+
+EStatus SegmentLogStorageImpl::AppendBatch(
+    const std::vector<eraftkv::Entry*>& etys) {
+  if (etys.empty()) {
+    return EStatus::kOk;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->AppendRecords(etys, false, true);
+}
+
+EStatus SegmentLogStorageImpl::AppendBatch(
+    const std::vector<eraftkv::Entry*>& etys,
+    int64_t                             commit_idx,
+    int64_t                             applied_idx) {
+  if (etys.empty()) {
+    return EStatus::kOk;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->commit_idx_ = commit_idx;
+  this->applied_idx_ = applied_idx;
+  this->has_meta_ = true;
+  return this->AppendRecords(etys, true, true);
+}
+
+EStatus SegmentLogStorageImpl::EraseBefore(int64_t first_index) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->first_idx_ = first_index;
+  // the active segment is never dropped, it holds the last meta record
+  while (this->segments_.size() > 1) {
+    LogSegment* segment = this->segments_.begin()->second;
+    if (segment->last_index >= first_index) {
+      break;
+    }
+    this->DropSegment(segment);
+  }
+  this->term_index_.CompactTo(first_index);
+  return this->AppendMeta(false);
+}
+
+EStatus SegmentLogStorageImpl::EraseAfter(int64_t from_index) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (from_index >= this->last_idx_) {
+    return EStatus::kOk;
+  }
+  return this->TruncateAfter(from_index);
+}
+
+LogSegment* SegmentLogStorageImpl::FindSegment(int64_t index) {
+  for (auto it = this->segments_.rbegin(); it != this->segments_.rend();
+       it++) {
+    if (it->second->first_index != -1 && it->second->first_index <= index &&
+        index <= it->second->last_index) {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+bool SegmentLogStorageImpl::ReadEntry(int64_t index, eraftkv::Entry* ety) {
+  if (index < this->first_idx_ || index > this->last_idx_) {
+    return false;
+  }
+  LogSegment* segment = this->FindSegment(index);
+  if (segment == nullptr) {
+    return false;
+  }
+  int64_t slot = (index - segment->first_index) / SEGMENT_LOG_INDEX_INTERVAL;
+  SegmentRecordReader reader(
+      segment->fd, segment->sparse_offsets[slot], segment->write_offset);
+  uint8_t     type;
+  const char* data;
+  uint32_t    len;
+  while (reader.Next(&type, &data, &len)) {
+    if (type != SEGMENT_LOG_ENTRY_RECORD) {
+      continue;
+    }
+    if (!ety->ParseFromArray(data, len) || ety->id() > index) {
+      return false;
+    }
+    if (ety->id() == index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+EStatus SegmentLogStorageImpl::Get(int64_t index, eraftkv::Entry* ety) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (!this->ReadEntry(index, ety)) {
+    ety->Clear();
+    return EStatus::kNotFound;
+  }
+  return EStatus::kOk;
+}
+
+/**
+ * @brief a range is read with one sequential scan per segment from the
+ * sparse index slot of its first entry
+ *
+ * @param start_index
+ * @param end_index
+ * @param entries
+ * @return EStatus
+ */
+EStatus SegmentLogStorageImpl::Gets(int64_t                      start_index,
+                                    int64_t                      end_index,
+                                    std::vector<eraftkv::Entry>* entries) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  size_t                      count = 0;
+  int64_t                     index = start_index;
+  int64_t                     read_end = std::min(end_index, this->last_idx_);
+  if (start_index < this->first_idx_) {
+    read_end = start_index - 1;
+  }
+  while (index <= read_end) {
+    LogSegment* segment = this->FindSegment(index);
+    if (segment == nullptr) {
+      break;
+    }
+    int64_t slot = (index - segment->first_index) / SEGMENT_LOG_INDEX_INTERVAL;
+    SegmentRecordReader reader(
+        segment->fd, segment->sparse_offsets[slot], segment->write_offset);
+    uint8_t     type;
+    const char* data;
+    uint32_t    len;
+    int64_t     segment_end = std::min(read_end, segment->last_index);
+    while (index <= segment_end && reader.Next(&type, &data, &len)) {
+      if (type != SEGMENT_LOG_ENTRY_RECORD) {
+        continue;
+      }
+      if (count == entries->size()) {
+        entries->emplace_back();
+      }
+      eraftkv::Entry& ety = (*entries)[count];
+      if (!ety.ParseFromArray(data, len) || ety.id() > index) {
+        break;
+      }
+      if (ety.id() == index) {
+        count++;
+        index++;
+      }
+    }
+    if (index <= segment_end) {
+      break;
+    }
+  }
+  entries->resize(count);
+  return index > end_index ? EStatus::kOk : EStatus::kNotFound;
+}
+
+int64_t SegmentLogStorageImpl::FirstIndex() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->first_idx_;
+}
+
+int64_t SegmentLogStorageImpl::LastIndex() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->last_idx_;
+}
+
+void SegmentLogStorageImpl::ResetFirstIndex(int64_t new_idx) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->first_idx_ = new_idx;
+}
+
+void SegmentLogStorageImpl::ResetFirstLogEntry(int64_t term, int64_t index) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  SPDLOG_INFO("reset first log with index {}, term {}", index, term);
+  if (this->FindSegment(index) == nullptr) {
+    eraftkv::Entry ety;
+    ety.set_e_type(eraftkv::EntryType::NoOp);
+    ety.set_id(index);
+    ety.set_term(term);
+    this->AppendRecords({&ety}, false, true);
+  }
+  this->first_idx_ = index;
+  this->term_index_.ResetFirst(index, term);
+  this->AppendMeta(false);
+}
+
+int64_t SegmentLogStorageImpl::LogCount() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->last_idx_ - this->first_idx_ + 1;
+}
+
+EStatus SegmentLogStorageImpl::GetFirstEty(eraftkv::Entry* ety) {
+  return this->Get(this->FirstIndex(), ety);
+}
+
+EStatus SegmentLogStorageImpl::GetLastEty(eraftkv::Entry* ety) {
+  return this->Get(this->LastIndex(), ety);
+}
+
+int64_t SegmentLogStorageImpl::Term(int64_t index) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  int64_t                     term = this->term_index_.Term(index);
+  if (term != -1) {
+    return term;
+  }
+  eraftkv::Entry ety;
+  return this->ReadEntry(index, &ety) ? ety.term() : 0;
+}
+
+int64_t SegmentLogStorageImpl::LastTerm() {
+  return this->Term(this->LastIndex());
+}
+
+int64_t SegmentLogStorageImpl::FirstIndexOfTerm(int64_t term) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->term_index_.FirstIndexOfTerm(term);
+}
+
+int64_t SegmentLogStorageImpl::LastIndexOfTerm(int64_t term) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->term_index_.LastIndexOfTerm(term);
+}
+
+void SegmentLogStorageImpl::ReleaseCache(int64_t index) {}
+
+EStatus SegmentLogStorageImpl::PersisLogMetaState(int64_t commit_idx,
+                                                  int64_t applied_idx) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->commit_idx_ = commit_idx;
+  this->applied_idx_ = applied_idx;
+  this->has_meta_ = true;
+  return this->AppendMeta(false);
+}
+
+EStatus SegmentLogStorageImpl::ReadMetaState(int64_t* commit_idx,
+                                             int64_t* applied_idx) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (!this->has_meta_) {
+    return EStatus::kError;
+  }
+  *commit_idx = this->commit_idx_;
+  *applied_idx = this->applied_idx_;
+  return EStatus::kOk;
+}
@@ -0,0 +1,316 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file segment_log_storage_impl.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "consts.h"
+#include "eraftkv.pb.h"
+#include "estatus.h"
+#include "log_term_index.h"
+#include "raft_log.h"
+
+/**
+ * @brief an append only log segment file, records are
+ * [len:4][type:1][crc64:8][payload] with len counting the type byte and the
+ * payload, a zero len marks the end of the written part of the
+ * preallocated file
+ *
+ */
+struct LogSegment {
+  int64_t     seq;
+  std::string path;
+  int         fd;
+  int64_t     write_offset;
+  int64_t     first_index;
+  int64_t     last_index;
+  /**
+   * @brief file offset of every SEGMENT_LOG_INDEX_INTERVAL-th entry record
+   * from first_index
+   *
+   */
+  std::vector<int64_t> sparse_offsets;
+};
+
+/**
+ * @brief raft log storage on fixed size append only segment files, entries
+ * are written once with a crc per record and one fdatasync per batch, the
+ * log is truncated by deleting or rewinding whole segments
+ *
+ */
+class SegmentLogStorageImpl : public LogStore {
+
+ public:
+  /**
+   * @brief open the segments in dir_path, or start a new log
+   *
+   * @param dir_path
+   * @param segment_size
+   */
+  SegmentLogStorageImpl(std::string dir_path,
+                        int64_t     segment_size = SEGMENT_LOG_FILE_SIZE);
+
+  ~SegmentLogStorageImpl();
+
+  EStatus Reinit();
+
+  /**
+   * @brief Append add new entries
+   *
+   * @param ety
+   * @return EStatus
+   */
+  EStatus Append(eraftkv::Entry* ety);
+
+  /**
+   * @brief AppendBatch add a batch of new entries with one fdatasync
+   *
+   * @param etys
+   * @return EStatus
+   */
+  EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys);
+
+  /**
+   * @brief AppendBatch add a batch of new entries followed by a log meta
+   * record, both made durable by one fdatasync
+   *
+   * @param etys
+   * @param commit_idx
+   * @param applied_idx
+   * @return EStatus
+   */
+  EStatus AppendBatch(const std::vector<eraftkv::Entry*>& etys,
+                      int64_t                             commit_idx,
+                      int64_t                             applied_idx);
+
+  /**
+   * @brief EraseBefore erase all entries before the given index, segments
+   * holding only erased entries are deleted
+   *
+   * @param first_index
+   * @return EStatus
+   */
+  EStatus EraseBefore(int64_t first_index);
+
+  /**
+   * @brief EraseAfter erase all entries after the given index, the segment
+   * holding it is rewound and the later segments are deleted
+   *
+   * @param from_index
+   * @return EStatus
+   */
+  EStatus EraseAfter(int64_t from_index);
+
+  /**
+   * @brief Get read the given index entry into ety
+   *
+   * @param index
+   * @param ety
+   * @return EStatus
+   */
+  EStatus Get(int64_t index, eraftkv::Entry* ety);
+
+  /**
+   * @brief Gets read the entries in [start_index, end_index] into entries
+   * with sequential segment reads
+   *
+   * @param start_index
+   * @param end_index
+   * @param entries
+   * @return EStatus kNotFound if the range is cut short by a missing entry
+   */
+  EStatus Gets(int64_t                      start_index,
+               int64_t                      end_index,
+               std::vector<eraftkv::Entry>* entries);
+
+  int64_t FirstIndex();
+
+  int64_t LastIndex();
+
+  void ResetFirstIndex(int64_t new_idx);
+
+  /**
+   * @brief make (index, term) the first entry, it is appended if the log
+   * does not reach index
+   *
+   * @param term
+   * @param index
+   */
+  void ResetFirstLogEntry(int64_t term, int64_t index);
+
+  int64_t LogCount();
+
+  EStatus GetFirstEty(eraftkv::Entry* ety);
+
+  EStatus GetLastEty(eraftkv::Entry* ety);
+
+  int64_t Term(int64_t index);
+
+  int64_t LastTerm();
+
+  int64_t FirstIndexOfTerm(int64_t term);
+
+  int64_t LastIndexOfTerm(int64_t term);
+
+  /**
+   * @brief segment reads are served by the page cache, nothing to release
+   *
+   * @param index
+   */
+  void ReleaseCache(int64_t index);
+
+  /**
+   * @brief append a log meta record, not synced on its own
+   *
+   * @param commit_idx
+   * @param applied_idx
+   * @return EStatus
+   */
+  EStatus PersisLogMetaState(int64_t commit_idx, int64_t applied_idx);
+
+  EStatus ReadMetaState(int64_t* commit_idx, int64_t* applied_idx);
+
+ private:
+  /**
+   * @brief scan all the segments, rebuild the sparse and term indexes and
+   * restore the last log meta record
+   *
+   * @return EStatus
+   */
+  EStatus Recover();
+
+  /**
+   * @brief scan the records of segment from its start
+   *
+   * @param segment
+   * @param meta_first_term term of the first entry in the last meta record
+   */
+  void LoadSegment(LogSegment* segment, int64_t* meta_first_term);
+
+  /**
+   * @brief create and preallocate the next segment file
+   *
+   * @return LogSegment*
+   */
+  LogSegment* NewSegment();
+
+  /**
+   * @brief remove segment from disk
+   *
+   * @param segment
+   */
+  void DropSegment(LogSegment* segment);
+
+  /**
+   * @brief append records to the active segments, a record that does not
+   * fit rolls over to a new segment, the data is fdatasynced if sync
+   *
+   * @param etys
+   * @param with_meta
+   * @param sync
+   * @return EStatus
+   */
+  EStatus AppendRecords(const std::vector<eraftkv::Entry*>& etys,
+                        bool                                with_meta,
+                        bool                                sync);
+
+  /**
+   * @brief erase the entries with id > index, caller holds mutex_
+   *
+   * @param index
+   * @return EStatus
+   */
+  EStatus TruncateAfter(int64_t index);
+
+  /**
+   * @brief read the entry record at index, caller holds mutex_
+   *
+   * @param index
+   * @param ety
+   * @return bool
+   */
+  bool ReadEntry(int64_t index, eraftkv::Entry* ety);
+
+  /**
+   * @brief append a log meta record and optionally fdatasync it, caller
+   * holds mutex_
+   *
+   * @param sync
+   * @return EStatus
+   */
+  EStatus AppendMeta(bool sync);
+
+  /**
+   * @brief encode the current log meta state as a meta record payload
+   *
+   * @return std::string
+   */
+  std::string EncodeMeta();
+
+  /**
+   * @brief segment holding the entry with id = index
+   *
+   * @param index
+   * @return LogSegment* nullptr if no segment holds it
+   */
+  LogSegment* FindSegment(int64_t index);
+
+  std::string dir_path_;
+
+  int64_t segment_size_;
+
+  /**
+   * @brief segments by seq, the last one is the active segment
+   *
+   */
+  std::map<int64_t, LogSegment*> segments_;
+
+  int64_t first_idx_;
+
+  int64_t last_idx_;
+
+  int64_t commit_idx_;
+
+  int64_t applied_idx_;
+
+  bool has_meta_;
+
+  LogTermIndex term_index_;
+
+  std::mutex mutex_;
+};
@@ -0,0 +1,198 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file segment_log_storage_impl_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include "segment_log_storage_impl.h"
+#include "util.h"
+
+static void AppendEntries(LogStore* log_store,
+                          int64_t   start,
+                          int64_t   end,
+                          int64_t   term) {
+  std::vector<eraftkv::Entry*> etys;
+  for (int64_t i = start; i <= end; i++) {
+    eraftkv::Entry* ety = new eraftkv::Entry();
+    ety->set_id(i);
+    ety->set_term(term);
+    ety->set_data("val" + std::to_string(i) + std::string(100, 'x'));
+    etys.push_back(ety);
+  }
+  ASSERT_EQ(log_store->AppendBatch(etys), EStatus::kOk);
+  for (auto e : etys) {
+    delete e;
+  }
+}
+
+TEST(SegmentLogStorageImplTest, AppendRecover) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog");
+  ASSERT_EQ(log_store->LastIndex(), 0);
+  AppendEntries(log_store, 1, 200, 1);
+  ASSERT_EQ(log_store->LastIndex(), 200);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(130, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.term(), 1);
+  ASSERT_EQ(ety.data().substr(0, 6), "val130");
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog");
+  ASSERT_EQ(log_store->FirstIndex(), 0);
+  ASSERT_EQ(log_store->LastIndex(), 200);
+  ASSERT_EQ(log_store->LastTerm(), 1);
+  std::vector<eraftkv::Entry> range;
+  ASSERT_EQ(log_store->Gets(60, 70, &range), EStatus::kOk);
+  ASSERT_EQ(range.size(), 11);
+  ASSERT_EQ(range[4].id(), 64);
+  ASSERT_EQ(log_store->Gets(199, 202, &range), EStatus::kNotFound);
+  ASSERT_EQ(range.size(), 2);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+TEST(SegmentLogStorageImplTest, RolloverAndEraseBefore) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  AppendEntries(log_store, 1, 300, 1);
+  size_t segment_count =
+      DirectoryTool::ListDirFiles("/tmp/testsegmentlog").size();
+  ASSERT_GT(segment_count, 5);
+  std::vector<eraftkv::Entry> range;
+  ASSERT_EQ(log_store->Gets(1, 300, &range), EStatus::kOk);
+  for (int64_t i = 0; i < 300; i++) {
+    ASSERT_EQ(range[i].id(), i + 1);
+  }
+  // segments holding only erased entries are deleted
+  ASSERT_EQ(log_store->EraseBefore(250), EStatus::kOk);
+  ASSERT_LT(DirectoryTool::ListDirFiles("/tmp/testsegmentlog").size(),
+            segment_count);
+  ASSERT_EQ(log_store->FirstIndex(), 250);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(249, &ety), EStatus::kNotFound);
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  ASSERT_EQ(log_store->FirstIndex(), 250);
+  ASSERT_EQ(log_store->LastIndex(), 300);
+  ASSERT_EQ(log_store->Term(250), 1);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+TEST(SegmentLogStorageImplTest, EraseAfterRewind) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  AppendEntries(log_store, 1, 100, 1);
+  ASSERT_EQ(log_store->EraseAfter(40), EStatus::kOk);
+  ASSERT_EQ(log_store->LastIndex(), 40);
+  AppendEntries(log_store, 41, 60, 2);
+  // overwriting an existing index truncates the log first
+  AppendEntries(log_store, 55, 58, 3);
+  ASSERT_EQ(log_store->LastIndex(), 58);
+  ASSERT_EQ(log_store->FirstIndexOfTerm(2), 41);
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  ASSERT_EQ(log_store->LastIndex(), 58);
+  ASSERT_EQ(log_store->Term(40), 1);
+  ASSERT_EQ(log_store->Term(54), 2);
+  ASSERT_EQ(log_store->LastTerm(), 3);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+TEST(SegmentLogStorageImplTest, ResendKeepsTail) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  AppendEntries(log_store, 1, 100, 1);
+  // entries already in the log with the same term are skipped
+  AppendEntries(log_store, 20, 30, 1);
+  ASSERT_EQ(log_store->LastIndex(), 100);
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  ASSERT_EQ(log_store->LastIndex(), 100);
+  eraftkv::Entry ety;
+  ASSERT_EQ(log_store->Get(31, &ety), EStatus::kOk);
+  ASSERT_EQ(ety.data().substr(0, 5), "val31");
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+TEST(SegmentLogStorageImplTest, MetaRecordsFitSegment) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  eraftkv::Entry ety;
+  for (int64_t i = 1; i <= 200; i++) {
+    ety.set_id(i);
+    ety.set_term(1);
+    ety.set_data(std::string(100 + i % 37, 'x'));
+    ASSERT_EQ(log_store->AppendBatch({&ety}, i, i - 1), EStatus::kOk);
+  }
+  for (auto path : DirectoryTool::ListDirFiles("/tmp/testsegmentlog")) {
+    struct stat st;
+    ASSERT_EQ(stat(path.c_str(), &st), 0);
+    ASSERT_LE(st.st_size, 4096);
+  }
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog", 4096);
+  int64_t commit_idx, applied_idx;
+  ASSERT_EQ(log_store->ReadMetaState(&commit_idx, &applied_idx), EStatus::kOk);
+  ASSERT_EQ(commit_idx, 200);
+  ASSERT_EQ(log_store->LastIndex(), 200);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+TEST(SegmentLogStorageImplTest, AppendBatchWithMeta) {
+  SegmentLogStorageImpl* log_store =
+      new SegmentLogStorageImpl("/tmp/testsegmentlog");
+  int64_t commit_idx, applied_idx;
+  ASSERT_EQ(log_store->ReadMetaState(&commit_idx, &applied_idx),
+            EStatus::kError);
+  eraftkv::Entry ety;
+  ety.set_id(1);
+  ety.set_term(1);
+  ASSERT_EQ(log_store->AppendBatch({&ety}, 1, 0), EStatus::kOk);
+  ASSERT_EQ(log_store->PersisLogMetaState(1, 1), EStatus::kOk);
+  delete log_store;
+  log_store = new SegmentLogStorageImpl("/tmp/testsegmentlog");
+  ASSERT_EQ(log_store->ReadMetaState(&commit_idx, &applied_idx), EStatus::kOk);
+  ASSERT_EQ(commit_idx, 1);
+  ASSERT_EQ(applied_idx, 1);
+  ASSERT_EQ(log_store->LastIndex(), 1);
+  delete log_store;
+  DirectoryTool::DeleteDir("/tmp/testsegmentlog");
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
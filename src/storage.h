@@ -33,12 +33,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "estatus.h"
 #include "raft_server.h"
 
 class RaftServer;
+namespace rocksdb {
+class PinnableSlice;
+}
 /**
  * @brief
  *
@@ -110,6 +114,14 @@ class Storage {
                                int64_t*    term,
                                int64_t*    vote) = 0;
 
+  /**
+   * @brief read the applied index stored with the applied data
+   *
+   * @param applied_idx
+   * @return EStatus
+   */
+  virtual EStatus ReadAppliedIdx(int64_t* applied_idx) = 0;
+
   /**
    * @brief
    *
@@ -117,7 +129,7 @@ class Storage {
    * @param val
    * @return EStatus
    */
-  virtual EStatus PutKV(std::string key, std::string val) = 0;
+  virtual EStatus PutKV(std::string_view key, std::string_view val) = 0;
 
   /**
    * @brief
@@ -125,7 +137,18 @@ class Storage {
    * @param key
    * @return std::string
    */
-  virtual std::pair<std::string, bool> GetKV(std::string key) = 0;
+  virtual std::pair<std::string, bool> GetKV(std::string_view key) = 0;
+
+  /**
+   * @brief read the value of key without copying it out of the store, the
+   * value stays pinned until value is reset or destroyed
+   *
+   * @param key
+   * @param value
+   * @return EStatus kNotFound if the key does not exist
+   */
+  virtual EStatus GetKV(std::string_view        key,
+                        rocksdb::PinnableSlice* value) = 0;
 
   /**
    * @brief
@@ -153,7 +176,7 @@ class Storage {
    * @param key
    * @return EStatus
    */
-  virtual EStatus DelKV(std::string key) = 0;
+  virtual EStatus DelKV(std::string_view key) = 0;
 
 
   virtual EStatus CreateCheckpoint(std::string snap_path) = 0;
@@ -0,0 +1,263 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file timer_wheel.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new Timer Wheel:: Timer Wheel object
+ *
+ * @param tick_ms
+ * @param slot_count
+ */
+TimerWheel::TimerWheel(int64_t tick_ms, int64_t slot_count)
+    : tick_ms_(tick_ms)
+    , start_time_(std::chrono::steady_clock::now())
+    , last_tick_(0)
+    , next_timer_id_(1)
+    , slots_(slot_count)
+    , arm_seq_(0) {}
+
+/**
+ * @brief Destroy the Timer Wheel:: Timer Wheel object
+ *
+ */
+TimerWheel::~TimerWheel() {}
+
+/**
+ * @brief
+ *
+ * @param delay_ms
+ * @param callback
+ * @return int64_t
+ */
+int64_t TimerWheel::AddTimer(int64_t delay_ms, std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  int64_t                     timer_id = this->next_timer_id_++;
+  WheelTimer&                 timer = this->timers_[timer_id];
+  timer.armed = false;
+  timer.generation = 0;
+  timer.callback = std::move(callback);
+  this->Link(timer_id, &timer, delay_ms);
+  this->cond_.notify_all();
+  return timer_id;
+}
+
+/**
+ * @brief
+ *
+ * @param timer_id
+ * @param delay_ms
+ * @return true
+ * @return false
+ */
+bool TimerWheel::ResetTimer(int64_t timer_id, int64_t delay_ms) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto                        it = this->timers_.find(timer_id);
+  if (it == this->timers_.end()) {
+    return false;
+  }
+  this->Unlink(&it->second);
+  this->Link(timer_id, &it->second, delay_ms);
+  this->cond_.notify_all();
+  return true;
+}
+
+/**
+ * @brief
+ *
+ * @param timer_id
+ * @return true
+ * @return false
+ */
+bool TimerWheel::CancelTimer(int64_t timer_id) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto                        it = this->timers_.find(timer_id);
+  if (it == this->timers_.end()) {
+    return false;
+  }
+  this->Unlink(&it->second);
+  this->timers_.erase(it);
+  return true;
+}
+
+/**
+ * @brief visit the slots of every tick elapsed since the last call, timers
+ * of a later round in the same slot are left in place. callbacks run after
+ * the wheel lock is released so they can re-arm timers, a timer reset or
+ * cancelled in the meantime is skipped
+ *
+ * @return int64_t
+ */
+int64_t TimerWheel::RunExpired() {
+  struct ExpiredTimer {
+    int64_t               timer_id;
+    uint64_t              generation;
+    std::function<void()> callback;
+  };
+  std::vector<ExpiredTimer> expired;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    int64_t                     now_tick = this->NowTick();
+    int64_t                     slot_count = this->slots_.size();
+    int64_t                     from_tick = this->last_tick_ + 1;
+    // after a stall longer than one turn every slot is visited once
+    if (now_tick - this->last_tick_ > slot_count) {
+      from_tick = now_tick - slot_count + 1;
+    }
+    for (int64_t tick = from_tick; tick <= now_tick; tick++) {
+      auto& slot = this->slots_[tick % slot_count];
+      for (auto it = slot.begin(); it != slot.end();) {
+        WheelTimer& timer = this->timers_[*it];
+        if (timer.expire_tick <= now_tick) {
+          timer.armed = false;
+          expired.push_back({*it, timer.generation, timer.callback});
+          it = slot.erase(it);
+        } else {
+          it++;
+        }
+      }
+    }
+    this->last_tick_ = std::max(this->last_tick_, now_tick);
+  }
+  int64_t fired = 0;
+  for (auto& ety : expired) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      auto                        it = this->timers_.find(ety.timer_id);
+      if (it == this->timers_.end() ||
+          it->second.generation != ety.generation) {
+        continue;
+      }
+    }
+    ety.callback();
+    fired++;
+  }
+  return fired;
+}
+
+/**
+ * @brief
+ *
+ * @param max_wait_ms
+ */
+void TimerWheel::WaitForExpire(int64_t max_wait_ms) {
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  int64_t                      arm_seq = this->arm_seq_;
+  int64_t                      wait_ms = max_wait_ms;
+  int64_t                      next_expire_ms = this->NextExpireMsLocked();
+  if (next_expire_ms >= 0 && next_expire_ms < wait_ms) {
+    wait_ms = next_expire_ms;
+  }
+  this->cond_.wait_for(lock, std::chrono::milliseconds(wait_ms), [&] {
+    return this->arm_seq_ != arm_seq;
+  });
+}
+
+/**
+ * @brief
+ *
+ * @return int64_t
+ */
+int64_t TimerWheel::NextExpireMs() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->NextExpireMsLocked();
+}
+
+int64_t TimerWheel::NextExpireMsLocked() {
+  int64_t earliest_tick = -1;
+  int64_t slot_count = this->slots_.size();
+  // a timer due within one turn sits in the slot of its own tick, so the
+  // first such slot holds the earliest deadline
+  for (int64_t tick = this->last_tick_ + 1;
+       tick <= this->last_tick_ + slot_count && earliest_tick == -1;
+       tick++) {
+    for (auto timer_id : this->slots_[tick % slot_count]) {
+      if (this->timers_[timer_id].expire_tick == tick) {
+        earliest_tick = tick;
+        break;
+      }
+    }
+  }
+  if (earliest_tick == -1) {
+    for (auto& it : this->timers_) {
+      if (it.second.armed &&
+          (earliest_tick == -1 || it.second.expire_tick < earliest_tick)) {
+        earliest_tick = it.second.expire_tick;
+      }
+    }
+  }
+  if (earliest_tick == -1) {
+    return -1;
+  }
+  int64_t elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - this->start_time_)
+                           .count();
+  return std::max<int64_t>(0, earliest_tick * this->tick_ms_ - elapsed_ms);
+}
+
+int64_t TimerWheel::NowTick() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - this->start_time_)
+             .count() /
+         this->tick_ms_;
+}
+
+void TimerWheel::Unlink(WheelTimer* timer) {
+  if (timer->armed) {
+    this->slots_[timer->expire_tick % this->slots_.size()].erase(
+        timer->slot_pos);
+    timer->armed = false;
+  }
+}
+
+/**
+ * @brief the delay is rounded up to whole ticks and a timer never lands in a
+ * tick that was already expired, so it fires no earlier than one tick before
+ * delay_ms
+ *
+ */
+void TimerWheel::Link(int64_t timer_id, WheelTimer* timer, int64_t delay_ms) {
+  int64_t expire_tick =
+      this->NowTick() + (delay_ms + this->tick_ms_ - 1) / this->tick_ms_;
+  if (expire_tick <= this->last_tick_) {
+    expire_tick = this->last_tick_ + 1;
+  }
+  auto& slot = this->slots_[expire_tick % this->slots_.size()];
+  timer->expire_tick = expire_tick;
+  timer->armed = true;
+  timer->generation++;
+  timer->slot_pos = slot.insert(slot.end(), timer_id);
+  this->arm_seq_++;
+}
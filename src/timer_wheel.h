@@ -0,0 +1,166 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file timer_wheel.h
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief a timer scheduled on the wheel, timers stay registered after they
+ * fire and can be re-armed with ResetTimer
+ *
+ */
+struct WheelTimer {
+  int64_t                     expire_tick;
+  bool                        armed;
+  uint64_t                    generation;
+  std::list<int64_t>::iterator slot_pos;
+  std::function<void()>       callback;
+};
+
+/**
+ * @brief hashed timer wheel, a timer is kept in the slot of its expire tick
+ * so adding, re-arming and expiring timers costs O(1) per timer
+ *
+ */
+class TimerWheel {
+
+ public:
+  /**
+   * @brief Construct a new Timer Wheel object
+   *
+   * @param tick_ms
+   * @param slot_count
+   */
+  TimerWheel(int64_t tick_ms, int64_t slot_count);
+
+  /**
+   * @brief Destroy the Timer Wheel object
+   *
+   */
+  ~TimerWheel();
+
+  /**
+   * @brief register a timer firing callback after delay_ms
+   *
+   * @param delay_ms
+   * @param callback
+   * @return int64_t timer id
+   */
+  int64_t AddTimer(int64_t delay_ms, std::function<void()> callback);
+
+  /**
+   * @brief re-arm a timer to fire after delay_ms, whether or not it already
+   * fired
+   *
+   * @param timer_id
+   * @param delay_ms
+   * @return true
+   * @return false timer not found
+   */
+  bool ResetTimer(int64_t timer_id, int64_t delay_ms);
+
+  /**
+   * @brief disarm and remove a timer, a callback already collected by
+   * RunExpired is skipped
+   *
+   * @param timer_id
+   * @return true
+   * @return false timer not found
+   */
+  bool CancelTimer(int64_t timer_id);
+
+  /**
+   * @brief run the callbacks of all expired timers on the calling thread
+   *
+   * @return int64_t count of fired timers
+   */
+  int64_t RunExpired();
+
+  /**
+   * @brief block until the earliest armed timer expires, a timer is
+   * (re)armed or max_wait_ms elapsed
+   *
+   * @param max_wait_ms
+   */
+  void WaitForExpire(int64_t max_wait_ms);
+
+  /**
+   * @brief ms until the earliest armed timer expires, -1 if none is armed
+   *
+   * @return int64_t
+   */
+  int64_t NextExpireMs();
+
+ private:
+  int64_t NowTick();
+
+  void Unlink(WheelTimer* timer);
+
+  void Link(int64_t timer_id, WheelTimer* timer, int64_t delay_ms);
+
+  int64_t NextExpireMsLocked();
+
+  int64_t tick_ms_;
+
+  std::chrono::steady_clock::time_point start_time_;
+
+  /**
+   * @brief ticks up to and including last_tick_ are expired
+   *
+   */
+  int64_t last_tick_;
+
+  int64_t next_timer_id_;
+
+  std::vector<std::list<int64_t>> slots_;
+
+  std::map<int64_t, WheelTimer> timers_;
+
+  /**
+   * @brief bumped whenever a timer is armed to wake WaitForExpire
+   *
+   */
+  int64_t arm_seq_;
+
+  std::mutex mutex_;
+
+  std::condition_variable cond_;
+};
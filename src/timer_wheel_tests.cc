@@ -0,0 +1,145 @@
+// MIT License
+
+// Copyright (c) 2023 ERaftGroup
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file timer_wheel_tests.cc
+ * @author ERaftGroup
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "timer_wheel.h"
+
+TEST(TimerWheelTest, Init) {
+  TimerWheel* wheel = new TimerWheel(10, 64);
+  ASSERT_EQ(-1, wheel->NextExpireMs());
+  ASSERT_EQ(0, wheel->RunExpired());
+  delete wheel;
+}
+
+TEST(TimerWheelTest, FireOnce) {
+  TimerWheel* wheel = new TimerWheel(10, 64);
+  int         fired = 0;
+  wheel->AddTimer(20, [&fired] { fired++; });
+  ASSERT_EQ(0, wheel->RunExpired());
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  ASSERT_EQ(1, wheel->RunExpired());
+  ASSERT_EQ(1, fired);
+  // fired timers stay registered but disarmed until reset
+  ASSERT_EQ(-1, wheel->NextExpireMs());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(0, wheel->RunExpired());
+  delete wheel;
+}
+
+TEST(TimerWheelTest, ResetAndCancel) {
+  TimerWheel* wheel = new TimerWheel(10, 64);
+  int         fired = 0;
+  int64_t     timer_id = wheel->AddTimer(20, [&fired] { fired++; });
+  ASSERT_TRUE(wheel->ResetTimer(timer_id, 1000));
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  ASSERT_EQ(0, wheel->RunExpired());
+  ASSERT_TRUE(wheel->CancelTimer(timer_id));
+  ASSERT_EQ(-1, wheel->NextExpireMs());
+  ASSERT_FALSE(wheel->ResetTimer(timer_id, 0));
+  ASSERT_FALSE(wheel->CancelTimer(timer_id));
+  timer_id = wheel->AddTimer(1000, [&fired] { fired++; });
+  ASSERT_TRUE(wheel->ResetTimer(timer_id, 0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(1, wheel->RunExpired());
+  ASSERT_EQ(1, fired);
+  ASSERT_FALSE(wheel->ResetTimer(timer_id + 1, 0));
+  ASSERT_FALSE(wheel->CancelTimer(timer_id + 1));
+  delete wheel;
+}
+
+TEST(TimerWheelTest, SkipTimerResetAfterCollect) {
+  TimerWheel* wheel = new TimerWheel(10, 64);
+  int         fired = 0;
+  int64_t     reset_id = 0;
+  int64_t     cancel_id = 0;
+  wheel->AddTimer(0, [&] {
+    wheel->ResetTimer(reset_id, 1000);
+    wheel->CancelTimer(cancel_id);
+  });
+  reset_id = wheel->AddTimer(0, [&fired] { fired++; });
+  cancel_id = wheel->AddTimer(0, [&fired] { fired++; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(15));
+  ASSERT_EQ(1, wheel->RunExpired());
+  ASSERT_EQ(0, fired);
+  ASSERT_GE(wheel->NextExpireMs(), 500);
+  delete wheel;
+}
+
+TEST(TimerWheelTest, DelayLongerThanOneTurn) {
+  TimerWheel* wheel = new TimerWheel(1, 8);
+  int         fired = 0;
+  wheel->AddTimer(30, [&fired] { fired++; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(12));
+  ASSERT_EQ(0, wheel->RunExpired());
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  ASSERT_EQ(1, wheel->RunExpired());
+  ASSERT_EQ(1, fired);
+  delete wheel;
+}
+
+TEST(TimerWheelTest, CallbackRearms) {
+  TimerWheel* wheel = new TimerWheel(10, 64);
+  int         fired = 0;
+  int64_t     timer_id = 0;
+  timer_id = wheel->AddTimer(0, [&] {
+    fired++;
+    wheel->ResetTimer(timer_id, 10);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(15));
+  ASSERT_EQ(1, wheel->RunExpired());
+  ASSERT_GE(wheel->NextExpireMs(), 0);
+  delete wheel;
+}
+
+TEST(TimerWheelTest, WaitWakesOnReset) {
+  TimerWheel*          wheel = new TimerWheel(10, 64);
+  std::atomic<int64_t> fired(0);
+  int64_t              timer_id =
+      wheel->AddTimer(60000, [&fired] { fired.fetch_add(1); });
+  std::thread waiter([wheel] {
+    wheel->WaitForExpire(60000);
+    wheel->RunExpired();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  auto start = std::chrono::steady_clock::now();
+  wheel->ResetTimer(timer_id, 0);
+  waiter.join();
+  auto waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  ASSERT_LT(waited_ms, 1000);
+  delete wheel;
+}
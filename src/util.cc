@@ -276,7 +276,90 @@ DirectoryTool::DirectoryTool() {}
  */
 DirectoryTool::~DirectoryTool() {}
 
+/**
+ * @brief crc64_slice_tab[k][n] is the crc of byte n followed by k zero
+ * bytes, crc64_slice_tab[0] is crc64_tab
+ *
+ */
+struct CRC64SliceTable {
+  uint64_t tab[8][256];
+
+  CRC64SliceTable() {
+    for (int n = 0; n < 256; n++) {
+      this->tab[0][n] = crc64_tab[n];
+    }
+    for (int k = 1; k < 8; k++) {
+      for (int n = 0; n < 256; n++) {
+        uint64_t crc = this->tab[k - 1][n];
+        this->tab[k][n] = crc64_tab[crc & 0xff] ^ (crc >> 8);
+      }
+    }
+  }
+};
+
+/**
+ * @brief the tables are built on first use, so a crc computed by another
+ * static initializer never sees them empty
+ *
+ * @return const CRC64SliceTable&
+ */
+static const CRC64SliceTable& CRC64SliceTab() {
+  static const CRC64SliceTable crc64_slice_tab;
+  return crc64_slice_tab;
+}
+
+/**
+ * @brief fold the eight bytes of the little endian word w into crc
+ *
+ * @param t
+ * @param crc
+ * @param w
+ * @return uint64_t
+ */
+static inline uint64_t CRC64Fold8(const uint64_t (*t)[256],
+                                  uint64_t crc,
+                                  uint64_t w) {
+  crc ^= w;
+  return t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+         t[5][(crc >> 16) & 0xff] ^ t[4][(crc >> 24) & 0xff] ^
+         t[3][(crc >> 32) & 0xff] ^ t[2][(crc >> 40) & 0xff] ^
+         t[1][(crc >> 48) & 0xff] ^ t[0][crc >> 56];
+}
+
+typedef uint64_t (*CRC64Kernel)(uint64_t crc, const char* s, uint64_t l);
+
+/**
+ * @brief slicing by 8 loads the input as little endian words, a big endian
+ * cpu keeps the byte at a time kernel
+ *
+ * @return CRC64Kernel
+ */
+static CRC64Kernel SelectCRC64Kernel() {
+  const uint16_t probe = 1;
+  uint8_t        low_byte;
+  std::memcpy(&low_byte, &probe, 1);
+  if (low_byte == 1) {
+    return &HashUtil::CRC64Slice8;
+  }
+  return &HashUtil::CRC64Bytewise;
+}
+
+/**
+ * @brief the kernel is selected on first use, so a crc computed by another
+ * static initializer never calls through an unset pointer
+ *
+ * @return CRC64Kernel
+ */
+static CRC64Kernel ActiveCRC64Kernel() {
+  static const CRC64Kernel crc64_kernel = SelectCRC64Kernel();
+  return crc64_kernel;
+}
+
 uint64_t HashUtil::CRC64(uint64_t crc, const char* s, uint64_t l) {
+  return ActiveCRC64Kernel()(crc, s, l);
+}
+
+uint64_t HashUtil::CRC64Bytewise(uint64_t crc, const char* s, uint64_t l) {
   uint64_t j;
 
   for (j = 0; j < l; j++) {
@@ -285,3 +368,55 @@ uint64_t HashUtil::CRC64(uint64_t crc, const char* s, uint64_t l) {
   }
   return crc;
 }
+
+uint64_t HashUtil::CRC64Slice8(uint64_t crc, const char* s, uint64_t l) {
+  const uint64_t(*t)[256] = CRC64SliceTab().tab;
+
+  uint64_t w;
+  for (; l >= 8; s += 8, l -= 8) {
+    std::memcpy(&w, s, sizeof(w));
+    crc = CRC64Fold8(t, crc, w);
+  }
+  return CRC64Bytewise(crc, s, l);
+}
+
+void HashUtil::CRC64Batch(const std::vector<std::string>& keys,
+                          std::vector<uint64_t>*          crcs) {
+  crcs->resize(keys.size());
+  size_t i = 0;
+  if (ActiveCRC64Kernel() == &HashUtil::CRC64Slice8) {
+    const uint64_t(*t)[256] = CRC64SliceTab().tab;
+    for (; i + 4 <= keys.size(); i += 4) {
+      const std::string* k = &keys[i];
+      uint64_t           c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+      uint64_t           w0, w1, w2, w3;
+      size_t             common = k[0].size();
+      for (int j = 1; j < 4; j++) {
+        common = k[j].size() < common ? k[j].size() : common;
+      }
+      common &= ~static_cast<size_t>(7);
+      // the four chains have no data dependency on each other, the cpu
+      // overlaps their table loads
+      for (size_t off = 0; off < common; off += 8) {
+        std::memcpy(&w0, k[0].data() + off, sizeof(w0));
+        std::memcpy(&w1, k[1].data() + off, sizeof(w1));
+        std::memcpy(&w2, k[2].data() + off, sizeof(w2));
+        std::memcpy(&w3, k[3].data() + off, sizeof(w3));
+        c0 = CRC64Fold8(t, c0, w0);
+        c1 = CRC64Fold8(t, c1, w1);
+        c2 = CRC64Fold8(t, c2, w2);
+        c3 = CRC64Fold8(t, c3, w3);
+      }
+      (*crcs)[i] = CRC64Slice8(c0, k[0].data() + common, k[0].size() - common);
+      (*crcs)[i + 1] =
+          CRC64Slice8(c1, k[1].data() + common, k[1].size() - common);
+      (*crcs)[i + 2] =
+          CRC64Slice8(c2, k[2].data() + common, k[2].size() - common);
+      (*crcs)[i + 3] =
+          CRC64Slice8(c3, k[3].data() + common, k[3].size() - common);
+    }
+  }
+  for (; i < keys.size(); i++) {
+    (*crcs)[i] = CRC64(0, keys[i].data(), keys[i].size());
+  }
+}
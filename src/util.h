@@ -35,6 +35,7 @@
 
 #include <stdint.h>
 
+#include <chrono>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
@@ -75,6 +76,34 @@ class EncodeDecodeTool {
     return result;
   }
 
+  /**
+   * @brief big endian encoding, the bytes of two values compare in the order
+   * of the values, for keys that must sort by number
+   *
+   * @param dst
+   * @param value
+   */
+  static void EncodeBigEndian64(char* dst, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+      dst[i] = static_cast<char>(value & 0xff);
+      value >>= 8;
+    }
+  }
+
+  static void PutBigEndian64(std::string* dst, uint64_t value) {
+    char buf[sizeof(value)];
+    EncodeBigEndian64(buf, value);
+    dst->append(buf, sizeof(buf));
+  }
+
+  static uint64_t DecodeBigEndian64(const uint8_t* buffer) {
+    uint64_t result = 0;
+    for (int i = 0; i < 8; i++) {
+      result = (result << 8) | buffer[i];
+    }
+    return result;
+  }
+
   static void EncodeFixed16(char* dst, uint16_t value) {
     uint8_t* const buffer = reinterpret_cast<uint8_t*>(dst);
     std::memcpy(buffer, &value, sizeof(uint16_t));
@@ -142,6 +171,27 @@ class RandomNumber {
   ~RandomNumber() = delete;
 };
 
+/**
+ * @brief
+ *
+ */
+class TimeUtil {
+ public:
+  /**
+   * @brief monotonic clock in milliseconds, for timeouts and leases
+   *
+   * @return int64_t
+   */
+  static int64_t SteadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  TimeUtil() = delete;
+  ~TimeUtil() = delete;
+};
+
 
 class StringUtil {
 
@@ -187,5 +237,45 @@ class StringUtil {
 
 class HashUtil {
  public:
+  /**
+   * @brief crc-64-jones of l bytes at s continued from crc, runs the fastest
+   * kernel this cpu supports
+   *
+   * @param crc
+   * @param s
+   * @param l
+   * @return uint64_t
+   */
   static uint64_t CRC64(uint64_t crc, const char* s, uint64_t l);
+
+  /**
+   * @brief crc-64-jones from 0 of every key, keys are hashed four at a time
+   * so the table lookups of different keys overlap
+   *
+   * @param keys
+   * @param crcs crcs[i] is the crc of keys[i]
+   */
+  static void CRC64Batch(const std::vector<std::string>& keys,
+                         std::vector<uint64_t>*          crcs);
+
+  /**
+   * @brief the byte at a time reference kernel
+   *
+   * @param crc
+   * @param s
+   * @param l
+   * @return uint64_t
+   */
+  static uint64_t CRC64Bytewise(uint64_t crc, const char* s, uint64_t l);
+
+  /**
+   * @brief the slicing by 8 kernel, folds eight bytes per step with eight
+   * lookup tables, needs a little endian cpu
+   *
+   * @param crc
+   * @param s
+   * @param l
+   * @return uint64_t
+   */
+  static uint64_t CRC64Slice8(uint64_t crc, const char* s, uint64_t l);
 };